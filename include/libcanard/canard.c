@@ -22,6 +22,29 @@
 #    define CANARD_PRIVATE static
 #endif
 
+/// Selects the implementation of the transfer CRC; the options trade ROM footprint for throughput:
+///     CANARD_CRC_BITWISE      -- eight shift-XOR steps per byte, no look-up tables. This is the default.
+///     CANARD_CRC_TABLE        -- one look-up per byte; adds 512 bytes of ROM.
+///     CANARD_CRC_SLICING_BY_8 -- eight bytes per iteration; adds 4 KiB of ROM. Worthwhile for large CAN FD transfers.
+#define CANARD_CRC_BITWISE 0
+#define CANARD_CRC_TABLE 1
+#define CANARD_CRC_SLICING_BY_8 2
+#ifndef CANARD_CONFIG_CRC
+#    define CANARD_CONFIG_CRC CANARD_CRC_BITWISE
+#endif
+#if (CANARD_CONFIG_CRC != CANARD_CRC_BITWISE) && (CANARD_CONFIG_CRC != CANARD_CRC_TABLE) && \
+    (CANARD_CONFIG_CRC != CANARD_CRC_SLICING_BY_8)
+#    error "Invalid CANARD_CONFIG_CRC"
+#endif
+
+/// If nonzero, the TX queue items are indexed by their transmission deadline in addition to the CAN ID, so that
+/// canardTxExpire() finds the expired transfers in logarithmic time. The index takes a tree node (three pointers and
+/// a balance factor) per queued frame and makes each push and pop update one more tree. If zero, canardTxExpire()
+/// scans the whole queue instead, which is acceptable if the queue is short or the function is invoked rarely.
+#ifndef CANARD_CONFIG_TX_DEADLINE_INDEX
+#    define CANARD_CONFIG_TX_DEADLINE_INDEX 1
+#endif
+
 #if !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 199901L)
 #    error "Unsupported language: ISO C99 or a newer version is required."
 #endif
@@ -62,13 +85,300 @@ typedef uint16_t TransferCRC;
 #define CRC_RESIDUE 0x0000U
 #define CRC_SIZE_BYTES 2U
 
+#if CANARD_CONFIG_CRC != CANARD_CRC_BITWISE
+#    if CANARD_CONFIG_CRC == CANARD_CRC_SLICING_BY_8
+#        define CRC_TABLE_COUNT 8U
+#    else
+#        define CRC_TABLE_COUNT 1U
+#    endif
+/// CRCTable[0][x] is the CRC of the byte x computed from the zero initial value.
+/// CRCTable[k][x] is the same followed by k zero bytes; these are used by the slicing-by-8 algorithm only.
+static const TransferCRC CRCTable[CRC_TABLE_COUNT][256] = {
+    {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+        0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+        0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+        0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+        0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+        0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+        0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+        0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+        0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+        0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+        0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+        0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+        0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+        0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+        0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+        0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+        0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+        0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+        0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+        0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+        0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+        0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+        0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+        0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+        0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+        0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+        0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+        0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+        0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+        0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+        0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+    },
+#    if CANARD_CONFIG_CRC == CANARD_CRC_SLICING_BY_8
+    {
+        0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xCCC4U, 0xFFF5U, 0xAAA6U, 0x9997U,
+        0x89A9U, 0xBA98U, 0xEFCBU, 0xDCFAU, 0x456DU, 0x765CU, 0x230FU, 0x103EU,
+        0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xCFB7U, 0xFC86U, 0xA9D5U, 0x9AE4U,
+        0x8ADAU, 0xB9EBU, 0xECB8U, 0xDF89U, 0x461EU, 0x752FU, 0x207CU, 0x134DU,
+        0x06E6U, 0x35D7U, 0x6084U, 0x53B5U, 0xCA22U, 0xF913U, 0xAC40U, 0x9F71U,
+        0x8F4FU, 0xBC7EU, 0xE92DU, 0xDA1CU, 0x438BU, 0x70BAU, 0x25E9U, 0x16D8U,
+        0x0595U, 0x36A4U, 0x63F7U, 0x50C6U, 0xC951U, 0xFA60U, 0xAF33U, 0x9C02U,
+        0x8C3CU, 0xBF0DU, 0xEA5EU, 0xD96FU, 0x40F8U, 0x73C9U, 0x269AU, 0x15ABU,
+        0x0DCCU, 0x3EFDU, 0x6BAEU, 0x589FU, 0xC108U, 0xF239U, 0xA76AU, 0x945BU,
+        0x8465U, 0xB754U, 0xE207U, 0xD136U, 0x48A1U, 0x7B90U, 0x2EC3U, 0x1DF2U,
+        0x0EBFU, 0x3D8EU, 0x68DDU, 0x5BECU, 0xC27BU, 0xF14AU, 0xA419U, 0x9728U,
+        0x8716U, 0xB427U, 0xE174U, 0xD245U, 0x4BD2U, 0x78E3U, 0x2DB0U, 0x1E81U,
+        0x0B2AU, 0x381BU, 0x6D48U, 0x5E79U, 0xC7EEU, 0xF4DFU, 0xA18CU, 0x92BDU,
+        0x8283U, 0xB1B2U, 0xE4E1U, 0xD7D0U, 0x4E47U, 0x7D76U, 0x2825U, 0x1B14U,
+        0x0859U, 0x3B68U, 0x6E3BU, 0x5D0AU, 0xC49DU, 0xF7ACU, 0xA2FFU, 0x91CEU,
+        0x81F0U, 0xB2C1U, 0xE792U, 0xD4A3U, 0x4D34U, 0x7E05U, 0x2B56U, 0x1867U,
+        0x1B98U, 0x28A9U, 0x7DFAU, 0x4ECBU, 0xD75CU, 0xE46DU, 0xB13EU, 0x820FU,
+        0x9231U, 0xA100U, 0xF453U, 0xC762U, 0x5EF5U, 0x6DC4U, 0x3897U, 0x0BA6U,
+        0x18EBU, 0x2BDAU, 0x7E89U, 0x4DB8U, 0xD42FU, 0xE71EU, 0xB24DU, 0x817CU,
+        0x9142U, 0xA273U, 0xF720U, 0xC411U, 0x5D86U, 0x6EB7U, 0x3BE4U, 0x08D5U,
+        0x1D7EU, 0x2E4FU, 0x7B1CU, 0x482DU, 0xD1BAU, 0xE28BU, 0xB7D8U, 0x84E9U,
+        0x94D7U, 0xA7E6U, 0xF2B5U, 0xC184U, 0x5813U, 0x6B22U, 0x3E71U, 0x0D40U,
+        0x1E0DU, 0x2D3CU, 0x786FU, 0x4B5EU, 0xD2C9U, 0xE1F8U, 0xB4ABU, 0x879AU,
+        0x97A4U, 0xA495U, 0xF1C6U, 0xC2F7U, 0x5B60U, 0x6851U, 0x3D02U, 0x0E33U,
+        0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xDA90U, 0xE9A1U, 0xBCF2U, 0x8FC3U,
+        0x9FFDU, 0xACCCU, 0xF99FU, 0xCAAEU, 0x5339U, 0x6008U, 0x355BU, 0x066AU,
+        0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xD9E3U, 0xEAD2U, 0xBF81U, 0x8CB0U,
+        0x9C8EU, 0xAFBFU, 0xFAECU, 0xC9DDU, 0x504AU, 0x637BU, 0x3628U, 0x0519U,
+        0x10B2U, 0x2383U, 0x76D0U, 0x45E1U, 0xDC76U, 0xEF47U, 0xBA14U, 0x8925U,
+        0x991BU, 0xAA2AU, 0xFF79U, 0xCC48U, 0x55DFU, 0x66EEU, 0x33BDU, 0x008CU,
+        0x13C1U, 0x20F0U, 0x75A3U, 0x4692U, 0xDF05U, 0xEC34U, 0xB967U, 0x8A56U,
+        0x9A68U, 0xA959U, 0xFC0AU, 0xCF3BU, 0x56ACU, 0x659DU, 0x30CEU, 0x03FFU,
+    },
+    {
+        0x0000U, 0x3730U, 0x6E60U, 0x5950U, 0xDCC0U, 0xEBF0U, 0xB2A0U, 0x8590U,
+        0xA9A1U, 0x9E91U, 0xC7C1U, 0xF0F1U, 0x7561U, 0x4251U, 0x1B01U, 0x2C31U,
+        0x4363U, 0x7453U, 0x2D03U, 0x1A33U, 0x9FA3U, 0xA893U, 0xF1C3U, 0xC6F3U,
+        0xEAC2U, 0xDDF2U, 0x84A2U, 0xB392U, 0x3602U, 0x0132U, 0x5862U, 0x6F52U,
+        0x86C6U, 0xB1F6U, 0xE8A6U, 0xDF96U, 0x5A06U, 0x6D36U, 0x3466U, 0x0356U,
+        0x2F67U, 0x1857U, 0x4107U, 0x7637U, 0xF3A7U, 0xC497U, 0x9DC7U, 0xAAF7U,
+        0xC5A5U, 0xF295U, 0xABC5U, 0x9CF5U, 0x1965U, 0x2E55U, 0x7705U, 0x4035U,
+        0x6C04U, 0x5B34U, 0x0264U, 0x3554U, 0xB0C4U, 0x87F4U, 0xDEA4U, 0xE994U,
+        0x1DADU, 0x2A9DU, 0x73CDU, 0x44FDU, 0xC16DU, 0xF65DU, 0xAF0DU, 0x983DU,
+        0xB40CU, 0x833CU, 0xDA6CU, 0xED5CU, 0x68CCU, 0x5FFCU, 0x06ACU, 0x319CU,
+        0x5ECEU, 0x69FEU, 0x30AEU, 0x079EU, 0x820EU, 0xB53EU, 0xEC6EU, 0xDB5EU,
+        0xF76FU, 0xC05FU, 0x990FU, 0xAE3FU, 0x2BAFU, 0x1C9FU, 0x45CFU, 0x72FFU,
+        0x9B6BU, 0xAC5BU, 0xF50BU, 0xC23BU, 0x47ABU, 0x709BU, 0x29CBU, 0x1EFBU,
+        0x32CAU, 0x05FAU, 0x5CAAU, 0x6B9AU, 0xEE0AU, 0xD93AU, 0x806AU, 0xB75AU,
+        0xD808U, 0xEF38U, 0xB668U, 0x8158U, 0x04C8U, 0x33F8U, 0x6AA8U, 0x5D98U,
+        0x71A9U, 0x4699U, 0x1FC9U, 0x28F9U, 0xAD69U, 0x9A59U, 0xC309U, 0xF439U,
+        0x3B5AU, 0x0C6AU, 0x553AU, 0x620AU, 0xE79AU, 0xD0AAU, 0x89FAU, 0xBECAU,
+        0x92FBU, 0xA5CBU, 0xFC9BU, 0xCBABU, 0x4E3BU, 0x790BU, 0x205BU, 0x176BU,
+        0x7839U, 0x4F09U, 0x1659U, 0x2169U, 0xA4F9U, 0x93C9U, 0xCA99U, 0xFDA9U,
+        0xD198U, 0xE6A8U, 0xBFF8U, 0x88C8U, 0x0D58U, 0x3A68U, 0x6338U, 0x5408U,
+        0xBD9CU, 0x8AACU, 0xD3FCU, 0xE4CCU, 0x615CU, 0x566CU, 0x0F3CU, 0x380CU,
+        0x143DU, 0x230DU, 0x7A5DU, 0x4D6DU, 0xC8FDU, 0xFFCDU, 0xA69DU, 0x91ADU,
+        0xFEFFU, 0xC9CFU, 0x909FU, 0xA7AFU, 0x223FU, 0x150FU, 0x4C5FU, 0x7B6FU,
+        0x575EU, 0x606EU, 0x393EU, 0x0E0EU, 0x8B9EU, 0xBCAEU, 0xE5FEU, 0xD2CEU,
+        0x26F7U, 0x11C7U, 0x4897U, 0x7FA7U, 0xFA37U, 0xCD07U, 0x9457U, 0xA367U,
+        0x8F56U, 0xB866U, 0xE136U, 0xD606U, 0x5396U, 0x64A6U, 0x3DF6U, 0x0AC6U,
+        0x6594U, 0x52A4U, 0x0BF4U, 0x3CC4U, 0xB954U, 0x8E64U, 0xD734U, 0xE004U,
+        0xCC35U, 0xFB05U, 0xA255U, 0x9565U, 0x10F5U, 0x27C5U, 0x7E95U, 0x49A5U,
+        0xA031U, 0x9701U, 0xCE51U, 0xF961U, 0x7CF1U, 0x4BC1U, 0x1291U, 0x25A1U,
+        0x0990U, 0x3EA0U, 0x67F0U, 0x50C0U, 0xD550U, 0xE260U, 0xBB30U, 0x8C00U,
+        0xE352U, 0xD462U, 0x8D32U, 0xBA02U, 0x3F92U, 0x08A2U, 0x51F2U, 0x66C2U,
+        0x4AF3U, 0x7DC3U, 0x2493U, 0x13A3U, 0x9633U, 0xA103U, 0xF853U, 0xCF63U,
+    },
+    {
+        0x0000U, 0x76B4U, 0xED68U, 0x9BDCU, 0xCAF1U, 0xBC45U, 0x2799U, 0x512DU,
+        0x85C3U, 0xF377U, 0x68ABU, 0x1E1FU, 0x4F32U, 0x3986U, 0xA25AU, 0xD4EEU,
+        0x1BA7U, 0x6D13U, 0xF6CFU, 0x807BU, 0xD156U, 0xA7E2U, 0x3C3EU, 0x4A8AU,
+        0x9E64U, 0xE8D0U, 0x730CU, 0x05B8U, 0x5495U, 0x2221U, 0xB9FDU, 0xCF49U,
+        0x374EU, 0x41FAU, 0xDA26U, 0xAC92U, 0xFDBFU, 0x8B0BU, 0x10D7U, 0x6663U,
+        0xB28DU, 0xC439U, 0x5FE5U, 0x2951U, 0x787CU, 0x0EC8U, 0x9514U, 0xE3A0U,
+        0x2CE9U, 0x5A5DU, 0xC181U, 0xB735U, 0xE618U, 0x90ACU, 0x0B70U, 0x7DC4U,
+        0xA92AU, 0xDF9EU, 0x4442U, 0x32F6U, 0x63DBU, 0x156FU, 0x8EB3U, 0xF807U,
+        0x6E9CU, 0x1828U, 0x83F4U, 0xF540U, 0xA46DU, 0xD2D9U, 0x4905U, 0x3FB1U,
+        0xEB5FU, 0x9DEBU, 0x0637U, 0x7083U, 0x21AEU, 0x571AU, 0xCCC6U, 0xBA72U,
+        0x753BU, 0x038FU, 0x9853U, 0xEEE7U, 0xBFCAU, 0xC97EU, 0x52A2U, 0x2416U,
+        0xF0F8U, 0x864CU, 0x1D90U, 0x6B24U, 0x3A09U, 0x4CBDU, 0xD761U, 0xA1D5U,
+        0x59D2U, 0x2F66U, 0xB4BAU, 0xC20EU, 0x9323U, 0xE597U, 0x7E4BU, 0x08FFU,
+        0xDC11U, 0xAAA5U, 0x3179U, 0x47CDU, 0x16E0U, 0x6054U, 0xFB88U, 0x8D3CU,
+        0x4275U, 0x34C1U, 0xAF1DU, 0xD9A9U, 0x8884U, 0xFE30U, 0x65ECU, 0x1358U,
+        0xC7B6U, 0xB102U, 0x2ADEU, 0x5C6AU, 0x0D47U, 0x7BF3U, 0xE02FU, 0x969BU,
+        0xDD38U, 0xAB8CU, 0x3050U, 0x46E4U, 0x17C9U, 0x617DU, 0xFAA1U, 0x8C15U,
+        0x58FBU, 0x2E4FU, 0xB593U, 0xC327U, 0x920AU, 0xE4BEU, 0x7F62U, 0x09D6U,
+        0xC69FU, 0xB02BU, 0x2BF7U, 0x5D43U, 0x0C6EU, 0x7ADAU, 0xE106U, 0x97B2U,
+        0x435CU, 0x35E8U, 0xAE34U, 0xD880U, 0x89ADU, 0xFF19U, 0x64C5U, 0x1271U,
+        0xEA76U, 0x9CC2U, 0x071EU, 0x71AAU, 0x2087U, 0x5633U, 0xCDEFU, 0xBB5BU,
+        0x6FB5U, 0x1901U, 0x82DDU, 0xF469U, 0xA544U, 0xD3F0U, 0x482CU, 0x3E98U,
+        0xF1D1U, 0x8765U, 0x1CB9U, 0x6A0DU, 0x3B20U, 0x4D94U, 0xD648U, 0xA0FCU,
+        0x7412U, 0x02A6U, 0x997AU, 0xEFCEU, 0xBEE3U, 0xC857U, 0x538BU, 0x253FU,
+        0xB3A4U, 0xC510U, 0x5ECCU, 0x2878U, 0x7955U, 0x0FE1U, 0x943DU, 0xE289U,
+        0x3667U, 0x40D3U, 0xDB0FU, 0xADBBU, 0xFC96U, 0x8A22U, 0x11FEU, 0x674AU,
+        0xA803U, 0xDEB7U, 0x456BU, 0x33DFU, 0x62F2U, 0x1446U, 0x8F9AU, 0xF92EU,
+        0x2DC0U, 0x5B74U, 0xC0A8U, 0xB61CU, 0xE731U, 0x9185U, 0x0A59U, 0x7CEDU,
+        0x84EAU, 0xF25EU, 0x6982U, 0x1F36U, 0x4E1BU, 0x38AFU, 0xA373U, 0xD5C7U,
+        0x0129U, 0x779DU, 0xEC41U, 0x9AF5U, 0xCBD8U, 0xBD6CU, 0x26B0U, 0x5004U,
+        0x9F4DU, 0xE9F9U, 0x7225U, 0x0491U, 0x55BCU, 0x2308U, 0xB8D4U, 0xCE60U,
+        0x1A8EU, 0x6C3AU, 0xF7E6U, 0x8152U, 0xD07FU, 0xA6CBU, 0x3D17U, 0x4BA3U,
+    },
+    {
+        0x0000U, 0xAA51U, 0x4483U, 0xEED2U, 0x8906U, 0x2357U, 0xCD85U, 0x67D4U,
+        0x022DU, 0xA87CU, 0x46AEU, 0xECFFU, 0x8B2BU, 0x217AU, 0xCFA8U, 0x65F9U,
+        0x045AU, 0xAE0BU, 0x40D9U, 0xEA88U, 0x8D5CU, 0x270DU, 0xC9DFU, 0x638EU,
+        0x0677U, 0xAC26U, 0x42F4U, 0xE8A5U, 0x8F71U, 0x2520U, 0xCBF2U, 0x61A3U,
+        0x08B4U, 0xA2E5U, 0x4C37U, 0xE666U, 0x81B2U, 0x2BE3U, 0xC531U, 0x6F60U,
+        0x0A99U, 0xA0C8U, 0x4E1AU, 0xE44BU, 0x839FU, 0x29CEU, 0xC71CU, 0x6D4DU,
+        0x0CEEU, 0xA6BFU, 0x486DU, 0xE23CU, 0x85E8U, 0x2FB9U, 0xC16BU, 0x6B3AU,
+        0x0EC3U, 0xA492U, 0x4A40U, 0xE011U, 0x87C5U, 0x2D94U, 0xC346U, 0x6917U,
+        0x1168U, 0xBB39U, 0x55EBU, 0xFFBAU, 0x986EU, 0x323FU, 0xDCEDU, 0x76BCU,
+        0x1345U, 0xB914U, 0x57C6U, 0xFD97U, 0x9A43U, 0x3012U, 0xDEC0U, 0x7491U,
+        0x1532U, 0xBF63U, 0x51B1U, 0xFBE0U, 0x9C34U, 0x3665U, 0xD8B7U, 0x72E6U,
+        0x171FU, 0xBD4EU, 0x539CU, 0xF9CDU, 0x9E19U, 0x3448U, 0xDA9AU, 0x70CBU,
+        0x19DCU, 0xB38DU, 0x5D5FU, 0xF70EU, 0x90DAU, 0x3A8BU, 0xD459U, 0x7E08U,
+        0x1BF1U, 0xB1A0U, 0x5F72U, 0xF523U, 0x92F7U, 0x38A6U, 0xD674U, 0x7C25U,
+        0x1D86U, 0xB7D7U, 0x5905U, 0xF354U, 0x9480U, 0x3ED1U, 0xD003U, 0x7A52U,
+        0x1FABU, 0xB5FAU, 0x5B28U, 0xF179U, 0x96ADU, 0x3CFCU, 0xD22EU, 0x787FU,
+        0x22D0U, 0x8881U, 0x6653U, 0xCC02U, 0xABD6U, 0x0187U, 0xEF55U, 0x4504U,
+        0x20FDU, 0x8AACU, 0x647EU, 0xCE2FU, 0xA9FBU, 0x03AAU, 0xED78U, 0x4729U,
+        0x268AU, 0x8CDBU, 0x6209U, 0xC858U, 0xAF8CU, 0x05DDU, 0xEB0FU, 0x415EU,
+        0x24A7U, 0x8EF6U, 0x6024U, 0xCA75U, 0xADA1U, 0x07F0U, 0xE922U, 0x4373U,
+        0x2A64U, 0x8035U, 0x6EE7U, 0xC4B6U, 0xA362U, 0x0933U, 0xE7E1U, 0x4DB0U,
+        0x2849U, 0x8218U, 0x6CCAU, 0xC69BU, 0xA14FU, 0x0B1EU, 0xE5CCU, 0x4F9DU,
+        0x2E3EU, 0x846FU, 0x6ABDU, 0xC0ECU, 0xA738U, 0x0D69U, 0xE3BBU, 0x49EAU,
+        0x2C13U, 0x8642U, 0x6890U, 0xC2C1U, 0xA515U, 0x0F44U, 0xE196U, 0x4BC7U,
+        0x33B8U, 0x99E9U, 0x773BU, 0xDD6AU, 0xBABEU, 0x10EFU, 0xFE3DU, 0x546CU,
+        0x3195U, 0x9BC4U, 0x7516U, 0xDF47U, 0xB893U, 0x12C2U, 0xFC10U, 0x5641U,
+        0x37E2U, 0x9DB3U, 0x7361U, 0xD930U, 0xBEE4U, 0x14B5U, 0xFA67U, 0x5036U,
+        0x35CFU, 0x9F9EU, 0x714CU, 0xDB1DU, 0xBCC9U, 0x1698U, 0xF84AU, 0x521BU,
+        0x3B0CU, 0x915DU, 0x7F8FU, 0xD5DEU, 0xB20AU, 0x185BU, 0xF689U, 0x5CD8U,
+        0x3921U, 0x9370U, 0x7DA2U, 0xD7F3U, 0xB027U, 0x1A76U, 0xF4A4U, 0x5EF5U,
+        0x3F56U, 0x9507U, 0x7BD5U, 0xD184U, 0xB650U, 0x1C01U, 0xF2D3U, 0x5882U,
+        0x3D7BU, 0x972AU, 0x79F8U, 0xD3A9U, 0xB47DU, 0x1E2CU, 0xF0FEU, 0x5AAFU,
+    },
+    {
+        0x0000U, 0x45A0U, 0x8B40U, 0xCEE0U, 0x06A1U, 0x4301U, 0x8DE1U, 0xC841U,
+        0x0D42U, 0x48E2U, 0x8602U, 0xC3A2U, 0x0BE3U, 0x4E43U, 0x80A3U, 0xC503U,
+        0x1A84U, 0x5F24U, 0x91C4U, 0xD464U, 0x1C25U, 0x5985U, 0x9765U, 0xD2C5U,
+        0x17C6U, 0x5266U, 0x9C86U, 0xD926U, 0x1167U, 0x54C7U, 0x9A27U, 0xDF87U,
+        0x3508U, 0x70A8U, 0xBE48U, 0xFBE8U, 0x33A9U, 0x7609U, 0xB8E9U, 0xFD49U,
+        0x384AU, 0x7DEAU, 0xB30AU, 0xF6AAU, 0x3EEBU, 0x7B4BU, 0xB5ABU, 0xF00BU,
+        0x2F8CU, 0x6A2CU, 0xA4CCU, 0xE16CU, 0x292DU, 0x6C8DU, 0xA26DU, 0xE7CDU,
+        0x22CEU, 0x676EU, 0xA98EU, 0xEC2EU, 0x246FU, 0x61CFU, 0xAF2FU, 0xEA8FU,
+        0x6A10U, 0x2FB0U, 0xE150U, 0xA4F0U, 0x6CB1U, 0x2911U, 0xE7F1U, 0xA251U,
+        0x6752U, 0x22F2U, 0xEC12U, 0xA9B2U, 0x61F3U, 0x2453U, 0xEAB3U, 0xAF13U,
+        0x7094U, 0x3534U, 0xFBD4U, 0xBE74U, 0x7635U, 0x3395U, 0xFD75U, 0xB8D5U,
+        0x7DD6U, 0x3876U, 0xF696U, 0xB336U, 0x7B77U, 0x3ED7U, 0xF037U, 0xB597U,
+        0x5F18U, 0x1AB8U, 0xD458U, 0x91F8U, 0x59B9U, 0x1C19U, 0xD2F9U, 0x9759U,
+        0x525AU, 0x17FAU, 0xD91AU, 0x9CBAU, 0x54FBU, 0x115BU, 0xDFBBU, 0x9A1BU,
+        0x459CU, 0x003CU, 0xCEDCU, 0x8B7CU, 0x433DU, 0x069DU, 0xC87DU, 0x8DDDU,
+        0x48DEU, 0x0D7EU, 0xC39EU, 0x863EU, 0x4E7FU, 0x0BDFU, 0xC53FU, 0x809FU,
+        0xD420U, 0x9180U, 0x5F60U, 0x1AC0U, 0xD281U, 0x9721U, 0x59C1U, 0x1C61U,
+        0xD962U, 0x9CC2U, 0x5222U, 0x1782U, 0xDFC3U, 0x9A63U, 0x5483U, 0x1123U,
+        0xCEA4U, 0x8B04U, 0x45E4U, 0x0044U, 0xC805U, 0x8DA5U, 0x4345U, 0x06E5U,
+        0xC3E6U, 0x8646U, 0x48A6U, 0x0D06U, 0xC547U, 0x80E7U, 0x4E07U, 0x0BA7U,
+        0xE128U, 0xA488U, 0x6A68U, 0x2FC8U, 0xE789U, 0xA229U, 0x6CC9U, 0x2969U,
+        0xEC6AU, 0xA9CAU, 0x672AU, 0x228AU, 0xEACBU, 0xAF6BU, 0x618BU, 0x242BU,
+        0xFBACU, 0xBE0CU, 0x70ECU, 0x354CU, 0xFD0DU, 0xB8ADU, 0x764DU, 0x33EDU,
+        0xF6EEU, 0xB34EU, 0x7DAEU, 0x380EU, 0xF04FU, 0xB5EFU, 0x7B0FU, 0x3EAFU,
+        0xBE30U, 0xFB90U, 0x3570U, 0x70D0U, 0xB891U, 0xFD31U, 0x33D1U, 0x7671U,
+        0xB372U, 0xF6D2U, 0x3832U, 0x7D92U, 0xB5D3U, 0xF073U, 0x3E93U, 0x7B33U,
+        0xA4B4U, 0xE114U, 0x2FF4U, 0x6A54U, 0xA215U, 0xE7B5U, 0x2955U, 0x6CF5U,
+        0xA9F6U, 0xEC56U, 0x22B6U, 0x6716U, 0xAF57U, 0xEAF7U, 0x2417U, 0x61B7U,
+        0x8B38U, 0xCE98U, 0x0078U, 0x45D8U, 0x8D99U, 0xC839U, 0x06D9U, 0x4379U,
+        0x867AU, 0xC3DAU, 0x0D3AU, 0x489AU, 0x80DBU, 0xC57BU, 0x0B9BU, 0x4E3BU,
+        0x91BCU, 0xD41CU, 0x1AFCU, 0x5F5CU, 0x971DU, 0xD2BDU, 0x1C5DU, 0x59FDU,
+        0x9CFEU, 0xD95EU, 0x17BEU, 0x521EU, 0x9A5FU, 0xDFFFU, 0x111FU, 0x54BFU,
+    },
+    {
+        0x0000U, 0xB861U, 0x60E3U, 0xD882U, 0xC1C6U, 0x79A7U, 0xA125U, 0x1944U,
+        0x93ADU, 0x2BCCU, 0xF34EU, 0x4B2FU, 0x526BU, 0xEA0AU, 0x3288U, 0x8AE9U,
+        0x377BU, 0x8F1AU, 0x5798U, 0xEFF9U, 0xF6BDU, 0x4EDCU, 0x965EU, 0x2E3FU,
+        0xA4D6U, 0x1CB7U, 0xC435U, 0x7C54U, 0x6510U, 0xDD71U, 0x05F3U, 0xBD92U,
+        0x6EF6U, 0xD697U, 0x0E15U, 0xB674U, 0xAF30U, 0x1751U, 0xCFD3U, 0x77B2U,
+        0xFD5BU, 0x453AU, 0x9DB8U, 0x25D9U, 0x3C9DU, 0x84FCU, 0x5C7EU, 0xE41FU,
+        0x598DU, 0xE1ECU, 0x396EU, 0x810FU, 0x984BU, 0x202AU, 0xF8A8U, 0x40C9U,
+        0xCA20U, 0x7241U, 0xAAC3U, 0x12A2U, 0x0BE6U, 0xB387U, 0x6B05U, 0xD364U,
+        0xDDECU, 0x658DU, 0xBD0FU, 0x056EU, 0x1C2AU, 0xA44BU, 0x7CC9U, 0xC4A8U,
+        0x4E41U, 0xF620U, 0x2EA2U, 0x96C3U, 0x8F87U, 0x37E6U, 0xEF64U, 0x5705U,
+        0xEA97U, 0x52F6U, 0x8A74U, 0x3215U, 0x2B51U, 0x9330U, 0x4BB2U, 0xF3D3U,
+        0x793AU, 0xC15BU, 0x19D9U, 0xA1B8U, 0xB8FCU, 0x009DU, 0xD81FU, 0x607EU,
+        0xB31AU, 0x0B7BU, 0xD3F9U, 0x6B98U, 0x72DCU, 0xCABDU, 0x123FU, 0xAA5EU,
+        0x20B7U, 0x98D6U, 0x4054U, 0xF835U, 0xE171U, 0x5910U, 0x8192U, 0x39F3U,
+        0x8461U, 0x3C00U, 0xE482U, 0x5CE3U, 0x45A7U, 0xFDC6U, 0x2544U, 0x9D25U,
+        0x17CCU, 0xAFADU, 0x772FU, 0xCF4EU, 0xD60AU, 0x6E6BU, 0xB6E9U, 0x0E88U,
+        0xABF9U, 0x1398U, 0xCB1AU, 0x737BU, 0x6A3FU, 0xD25EU, 0x0ADCU, 0xB2BDU,
+        0x3854U, 0x8035U, 0x58B7U, 0xE0D6U, 0xF992U, 0x41F3U, 0x9971U, 0x2110U,
+        0x9C82U, 0x24E3U, 0xFC61U, 0x4400U, 0x5D44U, 0xE525U, 0x3DA7U, 0x85C6U,
+        0x0F2FU, 0xB74EU, 0x6FCCU, 0xD7ADU, 0xCEE9U, 0x7688U, 0xAE0AU, 0x166BU,
+        0xC50FU, 0x7D6EU, 0xA5ECU, 0x1D8DU, 0x04C9U, 0xBCA8U, 0x642AU, 0xDC4BU,
+        0x56A2U, 0xEEC3U, 0x3641U, 0x8E20U, 0x9764U, 0x2F05U, 0xF787U, 0x4FE6U,
+        0xF274U, 0x4A15U, 0x9297U, 0x2AF6U, 0x33B2U, 0x8BD3U, 0x5351U, 0xEB30U,
+        0x61D9U, 0xD9B8U, 0x013AU, 0xB95BU, 0xA01FU, 0x187EU, 0xC0FCU, 0x789DU,
+        0x7615U, 0xCE74U, 0x16F6U, 0xAE97U, 0xB7D3U, 0x0FB2U, 0xD730U, 0x6F51U,
+        0xE5B8U, 0x5DD9U, 0x855BU, 0x3D3AU, 0x247EU, 0x9C1FU, 0x449DU, 0xFCFCU,
+        0x416EU, 0xF90FU, 0x218DU, 0x99ECU, 0x80A8U, 0x38C9U, 0xE04BU, 0x582AU,
+        0xD2C3U, 0x6AA2U, 0xB220U, 0x0A41U, 0x1305U, 0xAB64U, 0x73E6U, 0xCB87U,
+        0x18E3U, 0xA082U, 0x7800U, 0xC061U, 0xD925U, 0x6144U, 0xB9C6U, 0x01A7U,
+        0x8B4EU, 0x332FU, 0xEBADU, 0x53CCU, 0x4A88U, 0xF2E9U, 0x2A6BU, 0x920AU,
+        0x2F98U, 0x97F9U, 0x4F7BU, 0xF71AU, 0xEE5EU, 0x563FU, 0x8EBDU, 0x36DCU,
+        0xBC35U, 0x0454U, 0xDCD6U, 0x64B7U, 0x7DF3U, 0xC592U, 0x1D10U, 0xA571U,
+    },
+    {
+        0x0000U, 0x47D3U, 0x8FA6U, 0xC875U, 0x0F6DU, 0x48BEU, 0x80CBU, 0xC718U,
+        0x1EDAU, 0x5909U, 0x917CU, 0xD6AFU, 0x11B7U, 0x5664U, 0x9E11U, 0xD9C2U,
+        0x3DB4U, 0x7A67U, 0xB212U, 0xF5C1U, 0x32D9U, 0x750AU, 0xBD7FU, 0xFAACU,
+        0x236EU, 0x64BDU, 0xACC8U, 0xEB1BU, 0x2C03U, 0x6BD0U, 0xA3A5U, 0xE476U,
+        0x7B68U, 0x3CBBU, 0xF4CEU, 0xB31DU, 0x7405U, 0x33D6U, 0xFBA3U, 0xBC70U,
+        0x65B2U, 0x2261U, 0xEA14U, 0xADC7U, 0x6ADFU, 0x2D0CU, 0xE579U, 0xA2AAU,
+        0x46DCU, 0x010FU, 0xC97AU, 0x8EA9U, 0x49B1U, 0x0E62U, 0xC617U, 0x81C4U,
+        0x5806U, 0x1FD5U, 0xD7A0U, 0x9073U, 0x576BU, 0x10B8U, 0xD8CDU, 0x9F1EU,
+        0xF6D0U, 0xB103U, 0x7976U, 0x3EA5U, 0xF9BDU, 0xBE6EU, 0x761BU, 0x31C8U,
+        0xE80AU, 0xAFD9U, 0x67ACU, 0x207FU, 0xE767U, 0xA0B4U, 0x68C1U, 0x2F12U,
+        0xCB64U, 0x8CB7U, 0x44C2U, 0x0311U, 0xC409U, 0x83DAU, 0x4BAFU, 0x0C7CU,
+        0xD5BEU, 0x926DU, 0x5A18U, 0x1DCBU, 0xDAD3U, 0x9D00U, 0x5575U, 0x12A6U,
+        0x8DB8U, 0xCA6BU, 0x021EU, 0x45CDU, 0x82D5U, 0xC506U, 0x0D73U, 0x4AA0U,
+        0x9362U, 0xD4B1U, 0x1CC4U, 0x5B17U, 0x9C0FU, 0xDBDCU, 0x13A9U, 0x547AU,
+        0xB00CU, 0xF7DFU, 0x3FAAU, 0x7879U, 0xBF61U, 0xF8B2U, 0x30C7U, 0x7714U,
+        0xAED6U, 0xE905U, 0x2170U, 0x66A3U, 0xA1BBU, 0xE668U, 0x2E1DU, 0x69CEU,
+        0xFD81U, 0xBA52U, 0x7227U, 0x35F4U, 0xF2ECU, 0xB53FU, 0x7D4AU, 0x3A99U,
+        0xE35BU, 0xA488U, 0x6CFDU, 0x2B2EU, 0xEC36U, 0xABE5U, 0x6390U, 0x2443U,
+        0xC035U, 0x87E6U, 0x4F93U, 0x0840U, 0xCF58U, 0x888BU, 0x40FEU, 0x072DU,
+        0xDEEFU, 0x993CU, 0x5149U, 0x169AU, 0xD182U, 0x9651U, 0x5E24U, 0x19F7U,
+        0x86E9U, 0xC13AU, 0x094FU, 0x4E9CU, 0x8984U, 0xCE57U, 0x0622U, 0x41F1U,
+        0x9833U, 0xDFE0U, 0x1795U, 0x5046U, 0x975EU, 0xD08DU, 0x18F8U, 0x5F2BU,
+        0xBB5DU, 0xFC8EU, 0x34FBU, 0x7328U, 0xB430U, 0xF3E3U, 0x3B96U, 0x7C45U,
+        0xA587U, 0xE254U, 0x2A21U, 0x6DF2U, 0xAAEAU, 0xED39U, 0x254CU, 0x629FU,
+        0x0B51U, 0x4C82U, 0x84F7U, 0xC324U, 0x043CU, 0x43EFU, 0x8B9AU, 0xCC49U,
+        0x158BU, 0x5258U, 0x9A2DU, 0xDDFEU, 0x1AE6U, 0x5D35U, 0x9540U, 0xD293U,
+        0x36E5U, 0x7136U, 0xB943U, 0xFE90U, 0x3988U, 0x7E5BU, 0xB62EU, 0xF1FDU,
+        0x283FU, 0x6FECU, 0xA799U, 0xE04AU, 0x2752U, 0x6081U, 0xA8F4U, 0xEF27U,
+        0x7039U, 0x37EAU, 0xFF9FU, 0xB84CU, 0x7F54U, 0x3887U, 0xF0F2U, 0xB721U,
+        0x6EE3U, 0x2930U, 0xE145U, 0xA696U, 0x618EU, 0x265DU, 0xEE28U, 0xA9FBU,
+        0x4D8DU, 0x0A5EU, 0xC22BU, 0x85F8U, 0x42E0U, 0x0533U, 0xCD46U, 0x8A95U,
+        0x5357U, 0x1484U, 0xDCF1U, 0x9B22U, 0x5C3AU, 0x1BE9U, 0xD39CU, 0x944FU,
+    },
+#    endif
+};
+#endif
+
 CANARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte);
 CANARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte)
 {
+#if CANARD_CONFIG_CRC == CANARD_CRC_BITWISE
     static const TransferCRC Top  = 0x8000U;
     static const TransferCRC Poly = 0x1021U;
     TransferCRC              out  = crc ^ (uint16_t)((uint16_t)(byte) << BITS_PER_BYTE);
-    // Consider adding a compilation option that replaces this with a CRC table. Adds 512 bytes of ROM.
+    // The table-driven alternatives can be selected via CANARD_CONFIG_CRC at the cost of extra ROM.
     // Do not fold this into a loop because a size-optimizing compiler won't unroll it degrading the performance.
     out = (uint16_t)((uint16_t)(out << 1U) ^ (((out & Top) != 0U) ? Poly : 0U));
     out = (uint16_t)((uint16_t)(out << 1U) ^ (((out & Top) != 0U) ? Poly : 0U));
@@ -79,6 +389,9 @@ CANARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte)
     out = (uint16_t)((uint16_t)(out << 1U) ^ (((out & Top) != 0U) ? Poly : 0U));
     out = (uint16_t)((uint16_t)(out << 1U) ^ (((out & Top) != 0U) ? Poly : 0U));
     return out;
+#else
+    return (uint16_t)((uint16_t)(crc << BITS_PER_BYTE) ^ CRCTable[0][(uint8_t)((crc >> BITS_PER_BYTE) ^ byte)]);
+#endif
 }
 
 CANARD_PRIVATE TransferCRC crcAdd(const TransferCRC crc, const size_t size, const void* const data);
@@ -87,7 +400,23 @@ CANARD_PRIVATE TransferCRC crcAdd(const TransferCRC crc, const size_t size, cons
     CANARD_ASSERT((data != NULL) || (size == 0U));
     TransferCRC    out = crc;
     const uint8_t* p   = (const uint8_t*) data;
-    for (size_t i = 0; i < size; i++)
+    size_t         i   = 0U;
+#if CANARD_CONFIG_CRC == CANARD_CRC_SLICING_BY_8
+    // The register is folded into the first two bytes of each 8-byte block, then every byte is looked up in the
+    // table that accounts for the number of bytes following it in the block. Bytes are read one by one to avoid
+    // unaligned access and to stay independent of the byte order of the platform.
+    while ((size - i) >= 8U)
+    {
+        out = (uint16_t)(CRCTable[7][p[0] ^ (uint8_t)(out >> BITS_PER_BYTE)] ^
+                         CRCTable[6][p[1] ^ (uint8_t)(out & BYTE_MAX)] ^  //
+                         CRCTable[5][p[2]] ^ CRCTable[4][p[3]] ^          //
+                         CRCTable[3][p[4]] ^ CRCTable[2][p[5]] ^          //
+                         CRCTable[1][p[6]] ^ CRCTable[0][p[7]]);
+        p += 8U;
+        i += 8U;
+    }
+#endif
+    for (; i < size; i++)
     {
         out = crcAddByte(out, *p);
         ++p;
@@ -95,6 +424,261 @@ CANARD_PRIVATE TransferCRC crcAdd(const TransferCRC crc, const size_t size, cons
     return out;
 }
 
+// --------------------------------------------- AVL TREE ---------------------------------------------
+
+/// An intrusive AVL tree node. The tree is used to index queued objects so that the insertion point can be
+/// located in logarithmic time instead of walking a linked list. Nodes with equal keys are inserted to the right
+/// of the existing ones, which retains the FIFO order within the same key.
+/// The implementation follows the well-known algorithm described in Knuth's TAOCP vol. 3, section 6.2.3.
+typedef struct CanardInternalTreeNode
+{
+    struct CanardInternalTreeNode* up;     ///< NULL for the root.
+    struct CanardInternalTreeNode* lr[2];  ///< Left and right children; NULL if absent.
+    int8_t                         bf;     ///< Balance factor: the height of the right subtree minus the left one.
+} CanardInternalTreeNode;
+
+CANARD_PRIVATE void treeRotate(CanardInternalTreeNode* const x, const bool r);
+CANARD_PRIVATE void treeRotate(CanardInternalTreeNode* const x, const bool r)
+{
+    CANARD_ASSERT((x != NULL) && (x->lr[!r] != NULL) && ((x->bf >= -1) && (x->bf <= +1)));
+    CanardInternalTreeNode* const z = x->lr[!r];
+    if (x->up != NULL)
+    {
+        x->up->lr[x->up->lr[1] == x] = z;
+    }
+    z->up     = x->up;
+    x->up     = z;
+    x->lr[!r] = z->lr[r];
+    if (x->lr[!r] != NULL)
+    {
+        x->lr[!r]->up = x;
+    }
+    z->lr[r] = x;
+}
+
+/// Adjusts the balance factor of the node and rebalances the subtree if necessary.
+/// Returns the new root of the subtree, which is the same node unless a rotation took place.
+CANARD_PRIVATE CanardInternalTreeNode* treeAdjustBalance(CanardInternalTreeNode* const x, const bool increment);
+CANARD_PRIVATE CanardInternalTreeNode* treeAdjustBalance(CanardInternalTreeNode* const x, const bool increment)
+{
+    CANARD_ASSERT((x != NULL) && ((x->bf >= -1) && (x->bf <= +1)));
+    CanardInternalTreeNode* out    = x;
+    const int8_t            new_bf = (int8_t)(x->bf + (increment ? +1 : -1));
+    if ((new_bf < -1) || (new_bf > 1))
+    {
+        const bool                    r    = new_bf < 0;   // Left-heavy requires the right rotation and vice versa.
+        const int8_t                  sign = r ? +1 : -1;  // Positive if we are rotating right.
+        CanardInternalTreeNode* const z    = x->lr[!r];
+        CANARD_ASSERT(z != NULL);  // The heavy side cannot be empty.
+        if ((z->bf * sign) <= 0)   // The parent and the child are heavy on the same side or the child is balanced.
+        {
+            out = z;
+            treeRotate(x, r);
+            if (0 == z->bf)
+            {
+                x->bf = (int8_t)(-sign);
+                z->bf = (int8_t)(+sign);
+            }
+            else
+            {
+                x->bf = 0;
+                z->bf = 0;
+            }
+        }
+        else  // Otherwise, the child needs to be rotated in the opposite direction first.
+        {
+            CanardInternalTreeNode* const y = z->lr[r];
+            CANARD_ASSERT(y != NULL);  // The heavy side cannot be empty.
+            out = y;
+            treeRotate(z, !r);
+            treeRotate(x, r);
+            if ((y->bf * sign) < 0)
+            {
+                x->bf = (int8_t)(+sign);
+                y->bf = 0;
+                z->bf = 0;
+            }
+            else if ((y->bf * sign) > 0)
+            {
+                x->bf = 0;
+                y->bf = 0;
+                z->bf = (int8_t)(-sign);
+            }
+            else
+            {
+                x->bf = 0;
+                z->bf = 0;
+            }
+        }
+    }
+    else
+    {
+        x->bf = new_bf;  // No rebalancing needed, only the balance factor is updated.
+    }
+    return out;
+}
+
+/// Links the new node as the specified child of the parent (or as the root if the parent is NULL) and restores
+/// the balance of the tree. The time complexity is logarithmic.
+CANARD_PRIVATE void treeAttach(CanardInternalTreeNode** const root,
+                               CanardInternalTreeNode* const  parent,
+                               const bool                     r,
+                               CanardInternalTreeNode* const  node);
+CANARD_PRIVATE void treeAttach(CanardInternalTreeNode** const root,
+                               CanardInternalTreeNode* const  parent,
+                               const bool                     r,
+                               CanardInternalTreeNode* const  node)
+{
+    CANARD_ASSERT((root != NULL) && (node != NULL));
+    node->up    = parent;
+    node->lr[0] = NULL;
+    node->lr[1] = NULL;
+    node->bf    = 0;
+    if (NULL == parent)
+    {
+        CANARD_ASSERT(NULL == *root);
+        *root = node;
+    }
+    else
+    {
+        CANARD_ASSERT(NULL == parent->lr[r]);
+        parent->lr[r] = node;
+        // Retrace upwards until the height change is absorbed or the root is reached.
+        CanardInternalTreeNode* c = node;
+        CanardInternalTreeNode* p = parent;
+        while (p != NULL)
+        {
+            c = treeAdjustBalance(p, p->lr[1] == c);
+            p = c->up;
+            if (0 == c->bf)
+            {
+                break;  // The subtree became perfectly balanced, so its height is unchanged.
+            }
+        }
+        if (NULL == p)
+        {
+            *root = c;
+        }
+    }
+}
+
+/// Unlinks the node from the tree and restores the balance. The node itself is not modified.
+/// The time complexity is logarithmic.
+CANARD_PRIVATE void treeRemove(CanardInternalTreeNode** const root, const CanardInternalTreeNode* const node);
+CANARD_PRIVATE void treeRemove(CanardInternalTreeNode** const root, const CanardInternalTreeNode* const node)
+{
+    CANARD_ASSERT((root != NULL) && (*root != NULL) && (node != NULL));
+    CANARD_ASSERT((node->up != NULL) || (node == *root));
+    CanardInternalTreeNode* p = NULL;   // The lowest parent node that suffered a shortening of its subtree.
+    bool                    r = false;  // Which side of the above was shortened.
+    // Update the topology first and remember where to start the retracing from; the balance is restored afterwards.
+    if ((node->lr[0] != NULL) && (node->lr[1] != NULL))
+    {
+        CanardInternalTreeNode* re = node->lr[1];  // The replacement is the leftmost node of the right subtree.
+        while (re->lr[0] != NULL)
+        {
+            re = re->lr[0];
+        }
+        CANARD_ASSERT(re->up != NULL);
+        re->bf        = node->bf;
+        re->lr[0]     = node->lr[0];
+        re->lr[0]->up = re;
+        if (re->up != node)
+        {
+            p = re->up;  // Retracing starts with the ex-parent of the replacement node.
+            CANARD_ASSERT(p->lr[0] == re);
+            p->lr[0] = re->lr[1];  // Reducing the height of the left subtree here.
+            if (p->lr[0] != NULL)
+            {
+                p->lr[0]->up = p;
+            }
+            re->lr[1]     = node->lr[1];
+            re->lr[1]->up = re;
+            r             = false;
+        }
+        else  // The height of the right subtree of the replacement node is reduced.
+        {
+            p = re;
+            r = true;
+        }
+        re->up = node->up;
+        if (re->up != NULL)
+        {
+            re->up->lr[re->up->lr[1] == node] = re;
+        }
+        else
+        {
+            *root = re;
+        }
+    }
+    else  // Either or both of the children are NULL.
+    {
+        p             = node->up;
+        const bool rr = node->lr[1] != NULL;
+        if (node->lr[rr] != NULL)
+        {
+            node->lr[rr]->up = p;
+        }
+        if (p != NULL)
+        {
+            r        = p->lr[1] == node;
+            p->lr[r] = node->lr[rr];
+        }
+        else
+        {
+            *root = node->lr[rr];
+        }
+    }
+    // Climb up adjusting the balance factors until the root is reached or a node absorbs the height change.
+    if (p != NULL)
+    {
+        CanardInternalTreeNode* c = NULL;
+        for (;;)
+        {
+            c = treeAdjustBalance(p, !r);
+            p = c->up;
+            if ((c->bf != 0) || (NULL == p))
+            {
+                break;
+            }
+            r = p->lr[1] == c;
+        }
+        if (NULL == p)
+        {
+            CANARD_ASSERT(c != NULL);
+            *root = c;
+        }
+    }
+}
+
+/// Returns the in-order successor of the node if r is true, or its predecessor otherwise; NULL if there is none.
+/// The worst-case time complexity is logarithmic; traversing the entire tree this way takes linear time.
+CANARD_PRIVATE CanardInternalTreeNode* treeNeighbor(const CanardInternalTreeNode* const node, const bool r);
+CANARD_PRIVATE CanardInternalTreeNode* treeNeighbor(const CanardInternalTreeNode* const node, const bool r)
+{
+    CANARD_ASSERT(node != NULL);
+    CanardInternalTreeNode* out = NULL;
+    if (node->lr[r] != NULL)
+    {
+        out = node->lr[r];
+        while (out->lr[!r] != NULL)
+        {
+            out = out->lr[!r];
+        }
+    }
+    else
+    {
+        const CanardInternalTreeNode* c = node;
+        out                             = node->up;
+        while ((out != NULL) && (out->lr[r] == c))
+        {
+            c   = out;
+            out = out->up;
+        }
+    }
+    return out;
+}
+
 // --------------------------------------------- TRANSMISSION ---------------------------------------------
 
 /// This is a subclass of CanardFrame. A pointer to this type can be cast to CanardFrame safely.
@@ -106,6 +690,10 @@ typedef struct CanardInternalTxQueueItem
 {
     CanardFrame                       frame;
     struct CanardInternalTxQueueItem* next;
+    CanardInternalTreeNode            priority_node;  ///< Membership in the index ordered by CAN ID.
+#if CANARD_CONFIG_TX_DEADLINE_INDEX
+    CanardInternalTreeNode deadline_node;  ///< Membership in the index ordered by transmission deadline.
+#endif
 
     // Intentional violation of MISRA: this flex array is the lesser of three evils. The other two are:
     //  - Make the payload pointer point to the remainder of the allocated memory following this structure.
@@ -114,6 +702,94 @@ typedef struct CanardInternalTxQueueItem
     uint8_t payload_buffer[];  // NOSONAR
 } CanardInternalTxQueueItem;
 
+/// The slots of the preallocated TX queue storage (see canardTxInitSlab()) are laid out as this header followed by
+/// a queue item with room for the largest frame payload. The header links the enqueued slots in the order of their
+/// insertion, which is needed for the drop-oldest overflow policy; free slots are kept in a singly linked list
+/// using the older pointer.
+typedef struct CanardInternalTxSlabSlot
+{
+    struct CanardInternalTxSlabSlot* older;
+    struct CanardInternalTxSlabSlot* newer;
+} CanardInternalTxSlabSlot;
+
+/// The control block of the slab is placed at the beginning of the storage provided by the application.
+typedef struct CanardInternalTxSlab
+{
+    CanardInternalTxSlabSlot* free_list;
+    CanardInternalTxSlabSlot* oldest;  ///< The enqueued slot that was inserted earliest; NULL if the queue is empty.
+    CanardInternalTxSlabSlot* newest;
+    size_t                    slot_count;
+    size_t                    free_count;
+    size_t                    queued_count;  ///< The slots in the queue; the rest are held by the application.
+    CanardTxOverflowPolicy    policy;
+} CanardInternalTxSlab;
+
+#define TX_SLAB_ALIGNMENT ((sizeof(CanardMicrosecond) > sizeof(void*)) ? sizeof(CanardMicrosecond) : sizeof(void*))
+#define TX_SLAB_ALIGN_UP(x) ((((x) + TX_SLAB_ALIGNMENT) - 1U) & ~(TX_SLAB_ALIGNMENT - 1U))
+#define TX_SLAB_SLOT_HEADER_SIZE TX_SLAB_ALIGN_UP(sizeof(CanardInternalTxSlabSlot))
+#define TX_SLAB_SLOT_SIZE \
+    (TX_SLAB_SLOT_HEADER_SIZE + TX_SLAB_ALIGN_UP(sizeof(CanardInternalTxQueueItem) + CANARD_MTU_CAN_FD))
+
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromSlot(CanardInternalTxSlabSlot* const slot);
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromSlot(CanardInternalTxSlabSlot* const slot)
+{
+    CANARD_ASSERT(slot != NULL);
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the item within the slot.
+    return (CanardInternalTxQueueItem*) (void*) (((uint8_t*) slot) + TX_SLAB_SLOT_HEADER_SIZE);  // NOSONAR
+}
+
+CANARD_PRIVATE CanardInternalTxSlabSlot* txSlotFromItem(const CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE CanardInternalTxSlabSlot* txSlotFromItem(const CanardInternalTxQueueItem* const item)
+{
+    CANARD_ASSERT(item != NULL);
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the enclosing slot.
+    return (CanardInternalTxSlabSlot*) (void*) (((uint8_t*) item) - TX_SLAB_SLOT_HEADER_SIZE);  // NOSONAR
+}
+
+CANARD_PRIVATE void txSlabAgeAppend(CanardInternalTxSlab* const slab, CanardInternalTxSlabSlot* const slot);
+CANARD_PRIVATE void txSlabAgeAppend(CanardInternalTxSlab* const slab, CanardInternalTxSlabSlot* const slot)
+{
+    CANARD_ASSERT((slab != NULL) && (slot != NULL));
+    slot->older = slab->newest;
+    slot->newer = NULL;
+    slab->queued_count++;
+    if (slab->newest != NULL)
+    {
+        slab->newest->newer = slot;
+    }
+    else
+    {
+        slab->oldest = slot;
+    }
+    slab->newest = slot;
+}
+
+CANARD_PRIVATE void txSlabAgeRemove(CanardInternalTxSlab* const slab, CanardInternalTxSlabSlot* const slot);
+CANARD_PRIVATE void txSlabAgeRemove(CanardInternalTxSlab* const slab, CanardInternalTxSlabSlot* const slot)
+{
+    CANARD_ASSERT((slab != NULL) && (slot != NULL));
+    CANARD_ASSERT(slab->queued_count > 0U);
+    slab->queued_count--;
+    if (slot->older != NULL)
+    {
+        slot->older->newer = slot->newer;
+    }
+    else
+    {
+        slab->oldest = slot->newer;
+    }
+    if (slot->newer != NULL)
+    {
+        slot->newer->older = slot->older;
+    }
+    else
+    {
+        slab->newest = slot->older;
+    }
+    slot->older = NULL;
+    slot->newer = NULL;
+}
+
 CANARD_PRIVATE uint32_t txMakeMessageSessionSpecifier(const CanardPortID subject_id, const CanardNodeID src_node_id);
 CANARD_PRIVATE uint32_t txMakeMessageSessionSpecifier(const CanardPortID subject_id, const CanardNodeID src_node_id)
 {
@@ -255,116 +931,369 @@ CANARD_PRIVATE size_t txRoundFramePayloadSizeUp(const size_t x)
     return CanardCANDLCToLength[y];
 }
 
-CANARD_PRIVATE CanardInternalTxQueueItem* txAllocateQueueItem(CanardInstance* const   ins,
-                                                              const uint32_t          id,
-                                                              const CanardMicrosecond deadline_usec,
-                                                              const size_t            payload_size);
-CANARD_PRIVATE CanardInternalTxQueueItem* txAllocateQueueItem(CanardInstance* const   ins,
-                                                              const uint32_t          id,
-                                                              const CanardMicrosecond deadline_usec,
-                                                              const size_t            payload_size)
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromPriorityNode(CanardInternalTreeNode* const node);
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromPriorityNode(CanardInternalTreeNode* const node)
+{
+    CANARD_ASSERT(node != NULL);
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the enclosing object. Unavoidable.
+    return (CanardInternalTxQueueItem*) (void*) (((uint8_t*) node) -  // NOSONAR
+                                                 offsetof(CanardInternalTxQueueItem, priority_node));
+}
+
+#if CANARD_CONFIG_TX_DEADLINE_INDEX
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromDeadlineNode(CanardInternalTreeNode* const node);
+CANARD_PRIVATE CanardInternalTxQueueItem* txItemFromDeadlineNode(CanardInternalTreeNode* const node)
+{
+    CANARD_ASSERT(node != NULL);
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the enclosing object. Unavoidable.
+    return (CanardInternalTxQueueItem*) (void*) (((uint8_t*) node) -  // NOSONAR
+                                                 offsetof(CanardInternalTxQueueItem, deadline_node));
+}
+#endif
+
+/// Inserts the item into the prioritized transmission queue after all items whose CAN ID is not greater.
+/// If enabled, the item is also added to the deadline index after all items whose deadline is not later, so that the
+/// frames of a transfer, which share the same deadline, are ordered in the deadline index the same way as in the queue.
+/// The insertion points are located using the indexes, so the time complexity is logarithmic.
+CANARD_PRIVATE void txQueueInsert(CanardInstance* const ins, CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE void txQueueInsert(CanardInstance* const ins, CanardInternalTxQueueItem* const item)
 {
     CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(payload_size > 0U);
-    CanardInternalTxQueueItem* const out =
-        (CanardInternalTxQueueItem*) ins->memory_allocate(ins, sizeof(CanardInternalTxQueueItem) + payload_size);
-    if (out != NULL)
+    CANARD_ASSERT(item != NULL);
+    CANARD_ASSERT(item->frame.extended_can_id <= CAN_EXT_ID_MASK);
+    // The supremum is the last node where the descent turned right: the element after which the new one goes.
+    CanardInternalTxQueueItem* sup    = NULL;
+    CanardInternalTreeNode*    parent = NULL;
+    CanardInternalTreeNode*    n      = ins->_tx_queue_root;
+    bool                       r      = false;
+    while (n != NULL)
     {
-        out->next                  = NULL;
-        out->frame.timestamp_usec  = deadline_usec;
-        out->frame.payload_size    = payload_size;
-        out->frame.payload         = out->payload_buffer;
-        out->frame.extended_can_id = id;
+        CanardInternalTxQueueItem* const it = txItemFromPriorityNode(n);
+        r                                   = it->frame.extended_can_id <= item->frame.extended_can_id;
+        if (r)
+        {
+            sup = it;
+        }
+        parent = n;
+        n      = n->lr[r];
+    }
+    treeAttach(&ins->_tx_queue_root, parent, r, &item->priority_node);
+    CANARD_ASSERT((sup == NULL) || (sup->frame.extended_can_id <= item->frame.extended_can_id));
+    if (sup != NULL)
+    {
+        item->next = sup->next;
+        sup->next  = item;
+    }
+    else
+    {
+        item->next     = ins->_tx_queue;
+        ins->_tx_queue = item;
+    }
+#if CANARD_CONFIG_TX_DEADLINE_INDEX
+    parent = NULL;
+    n      = ins->_tx_deadline_root;
+    r      = false;
+    while (n != NULL)
+    {
+        r      = txItemFromDeadlineNode(n)->frame.timestamp_usec <= item->frame.timestamp_usec;
+        parent = n;
+        n      = n->lr[r];
+    }
+    treeAttach(&ins->_tx_deadline_root, parent, r, &item->deadline_node);
+#endif
+    if (ins->_tx_slab != NULL)
+    {
+        txSlabAgeAppend(ins->_tx_slab, txSlotFromItem(item));
     }
-    return out;
 }
 
-/// Returns the element after which new elements with the specified CAN ID should be inserted.
-/// Returns NULL if the element shall be inserted in the beginning of the list (i.e., no prior elements).
-CANARD_PRIVATE CanardInternalTxQueueItem* txFindQueueSupremum(const CanardInstance* const ins, const uint32_t can_id);
-CANARD_PRIVATE CanardInternalTxQueueItem* txFindQueueSupremum(const CanardInstance* const ins, const uint32_t can_id)
+/// Removes the item from the prioritized transmission queue. The memory is not released.
+/// The caller supplies the predecessor of the item in the queue, which is NULL if the item is the head.
+CANARD_PRIVATE void txQueueRemove(CanardInstance* const                  ins,
+                                  CanardInternalTxQueueItem* const       prev,
+                                  const CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE void txQueueRemove(CanardInstance* const                  ins,
+                                  CanardInternalTxQueueItem* const       prev,
+                                  const CanardInternalTxQueueItem* const item)
 {
     CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(can_id <= CAN_EXT_ID_MASK);
-    CanardInternalTxQueueItem* out = ins->_tx_queue;
-    if ((NULL == out) || (out->frame.extended_can_id > can_id))
+    CANARD_ASSERT(item != NULL);
+    CANARD_ASSERT((NULL == prev) ? (ins->_tx_queue == item) : (prev->next == item));
+    treeRemove(&ins->_tx_queue_root, &item->priority_node);
+#if CANARD_CONFIG_TX_DEADLINE_INDEX
+    treeRemove(&ins->_tx_deadline_root, &item->deadline_node);
+#endif
+    if (NULL == prev)
     {
-        out = NULL;
+        ins->_tx_queue = item->next;
     }
     else
     {
-        // TODO The linear search should be replaced with O(log n) at least. Please help us here.
-        while ((out != NULL) && (out->next != NULL) && (out->next->frame.extended_can_id <= can_id))
-        {
-            out = out->next;
-        }
+        prev->next = item->next;
+    }
+    if (ins->_tx_slab != NULL)
+    {
+        txSlabAgeRemove(ins->_tx_slab, txSlotFromItem(item));
     }
-    CANARD_ASSERT((out == NULL) || (out->frame.extended_can_id <= can_id));
-    return out;
 }
 
-/// Returns the number of frames enqueued or error (i.e., =1 or <0).
-CANARD_PRIVATE int32_t txPushSingleFrame(CanardInstance* const   ins,
-                                         const CanardMicrosecond deadline_usec,
-                                         const uint32_t          can_id,
-                                         const CanardTransferID  transfer_id,
-                                         const size_t            payload_size,
-                                         const void* const       payload);
-CANARD_PRIVATE int32_t txPushSingleFrame(CanardInstance* const   ins,
-                                         const CanardMicrosecond deadline_usec,
-                                         const uint32_t          can_id,
-                                         const CanardTransferID  transfer_id,
-                                         const size_t            payload_size,
-                                         const void* const       payload)
+/// Returns the item that precedes the specified one in the queue, or NULL if it is the head.
+CANARD_PRIVATE CanardInternalTxQueueItem* txQueuePredecessor(const CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE CanardInternalTxQueueItem* txQueuePredecessor(const CanardInternalTxQueueItem* const item)
+{
+    CANARD_ASSERT(item != NULL);
+    CanardInternalTreeNode* const node = treeNeighbor(&item->priority_node, false);
+    return (node != NULL) ? txItemFromPriorityNode(node) : NULL;
+}
+
+/// Tells whether the item occupies a slot of the slab rather than a fragment of the heap.
+CANARD_PRIVATE bool txSlabOwns(const CanardInternalTxSlab* const slab, const CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE bool txSlabOwns(const CanardInternalTxSlab* const slab, const CanardInternalTxQueueItem* const item)
+{
+    CANARD_ASSERT((slab != NULL) && (item != NULL));
+    // Intentional violation of MISRA: pointer arithmetics is required to locate the bounds of the slot array.
+    const uint8_t* const begin = ((const uint8_t*) slab) + TX_SLAB_ALIGN_UP(sizeof(CanardInternalTxSlab));  // NOSONAR
+    const uint8_t* const end   = begin + (slab->slot_count * TX_SLAB_SLOT_SIZE);                           // NOSONAR
+    return (((const uint8_t*) item) >= begin) && (((const uint8_t*) item) < end);
+}
+
+/// Returns the memory of a queue item back to where it came from: either the slab or the heap. The origin is told
+/// by the address, so the frames allocated from the heap before the slab was installed are freed correctly.
+CANARD_PRIVATE void txFreeQueueItem(CanardInstance* const ins, CanardInternalTxQueueItem* const item);
+CANARD_PRIVATE void txFreeQueueItem(CanardInstance* const ins, CanardInternalTxQueueItem* const item)
 {
     CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT((payload != NULL) || (payload_size == 0));
+    if ((ins->_tx_slab != NULL) && (item != NULL) && txSlabOwns(ins->_tx_slab, item))
+    {
+        CanardInternalTxSlabSlot* const slot = txSlotFromItem(item);
+        slot->older                          = ins->_tx_slab->free_list;
+        slot->newer                          = NULL;
+        ins->_tx_slab->free_list             = slot;
+        ins->_tx_slab->free_count++;
+        CANARD_ASSERT(ins->_tx_slab->free_count <= ins->_tx_slab->slot_count);
+    }
+    else
+    {
+        ins->memory_free(ins, item);  // May be NULL, which is OK.
+    }
+}
 
-    const size_t frame_payload_size = txRoundFramePayloadSizeUp(payload_size + 1U);
-    CANARD_ASSERT(frame_payload_size > payload_size);
-    const size_t padding_size = frame_payload_size - payload_size - 1U;
-    CANARD_ASSERT((padding_size + payload_size + 1U) == frame_payload_size);
-    int32_t out = 0;
+/// Removes the frames of one transfer from the queue and releases their memory. The first item shall be the first
+/// remaining frame of the transfer; all frames up to and including the end-of-transfer frame are dropped.
+/// The frames of a transfer are always contiguous in the queue because they are enqueued after all frames with
+/// the same CAN ID. Returns the number of frames dropped.
+CANARD_PRIVATE size_t txQueueDropTransfer(CanardInstance* const ins, CanardInternalTxQueueItem* const first);
+CANARD_PRIVATE size_t txQueueDropTransfer(CanardInstance* const ins, CanardInternalTxQueueItem* const first)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(first != NULL);
+    CanardInternalTxQueueItem* const prev = txQueuePredecessor(first);
+    CanardInternalTxQueueItem*       item = first;
+    size_t                           out  = 0U;
+    bool                             eot  = false;
+    while (!eot)
+    {
+        CANARD_ASSERT(item != NULL);
+        CanardInternalTxQueueItem* const next = item->next;
+        eot = (item->payload_buffer[item->frame.payload_size - 1U] & TAIL_END_OF_TRANSFER) != 0U;
+        CANARD_ASSERT(eot || ((next != NULL) && (next->frame.extended_can_id == item->frame.extended_can_id)));
+        txQueueRemove(ins, prev, item);
+        txFreeQueueItem(ins, item);
+        ++out;
+        item = next;
+    }
+    return out;
+}
 
-    CanardInternalTxQueueItem* const tqi = txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size);
-    if (tqi != NULL)
+/// Drops one transfer from the queue according to the overflow policy of the slab to make room for a new frame
+/// with the specified CAN ID. Returns truth if a transfer was dropped, falsity if there was nothing eligible.
+CANARD_PRIVATE bool txSlabEvict(CanardInstance* const ins, const uint32_t can_id);
+CANARD_PRIVATE bool txSlabEvict(CanardInstance* const ins, const uint32_t can_id)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->_tx_slab != NULL));
+    CanardInternalTxQueueItem* victim = NULL;
+    if (CanardTxOverflowDropOldest == ins->_tx_slab->policy)
     {
-        if (payload_size > 0U)  // The check is needed to avoid calling memcpy() with a NULL pointer, it's an UB.
+        if (ins->_tx_slab->oldest != NULL)
         {
-            CANARD_ASSERT(payload != NULL);
-            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            (void) memcpy(&tqi->payload_buffer[0], payload, payload_size);  // NOLINT
+            victim = txItemFromSlot(ins->_tx_slab->oldest);  // Always the first remaining frame of its transfer.
         }
-
-        // Clang-Tidy raises an error recommending the use of memset_s() instead.
-        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-        (void) memset(&tqi->payload_buffer[payload_size], PADDING_BYTE_VALUE, padding_size);  // NOLINT
-
-        tqi->payload_buffer[frame_payload_size - 1U] = txMakeTailByte(true, true, true, transfer_id);
-        CanardInternalTxQueueItem* const sup         = txFindQueueSupremum(ins, can_id);
-        if (sup != NULL)
+    }
+    else if ((CanardTxOverflowDropLowestPriority == ins->_tx_slab->policy) && (ins->_tx_queue_root != NULL))
+    {
+        // The rightmost item is the last frame of the lowest-priority transfer. Only lower priority can be dropped.
+        CanardInternalTreeNode* last = ins->_tx_queue_root;
+        while (last->lr[1] != NULL)
         {
-            tqi->next = sup->next;
-            sup->next = tqi;
+            last = last->lr[1];
+        }
+        victim = txItemFromPriorityNode(last);
+        if (victim->frame.extended_can_id > can_id)
+        {
+            // Rewind to the first remaining frame of the transfer.
+            CanardInternalTxQueueItem* prev = txQueuePredecessor(victim);
+            while (((victim->payload_buffer[victim->frame.payload_size - 1U] & TAIL_START_OF_TRANSFER) == 0U) &&
+                   (prev != NULL) && (prev->frame.extended_can_id == victim->frame.extended_can_id))
+            {
+                victim = prev;
+                prev   = txQueuePredecessor(victim);
+            }
         }
         else
         {
-            tqi->next      = ins->_tx_queue;
-            ins->_tx_queue = tqi;
+            victim = NULL;
         }
-        out = 1;  // One frame enqueued.
     }
     else
     {
-        out = -CANARD_ERROR_OUT_OF_MEMORY;
+        CANARD_ASSERT((CanardTxOverflowReject == ins->_tx_slab->policy) || (NULL == ins->_tx_queue_root));
     }
-    CANARD_ASSERT((out < 0) || (out == 1));
-    return out;
+    if (victim != NULL)
+    {
+        (void) txQueueDropTransfer(ins, victim);
+    }
+    return victim != NULL;
 }
 
-/// Returns the number of frames enqueued or error.
-CANARD_PRIVATE int32_t txPushMultiFrame(CanardInstance* const   ins,
+/// Tells whether the slab can provide the specified number of slots for a new transfer with the specified CAN ID,
+/// either from the free slots or by evicting transfers as permitted by the overflow policy. This is checked before
+/// anything is evicted, so that a transfer that cannot be accommodated anyway does not flush the queue in vain.
+/// The time complexity is linear from the number of frames of the new transfer.
+CANARD_PRIVATE bool txSlabCanAccommodate(const CanardInstance* const ins,
+                                         const uint32_t              can_id,
+                                         const size_t                frame_count);
+CANARD_PRIVATE bool txSlabCanAccommodate(const CanardInstance* const ins,
+                                         const uint32_t              can_id,
+                                         const size_t                frame_count)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->_tx_slab != NULL));
+    size_t available = ins->_tx_slab->free_count;
+    if (available >= frame_count)
+    {
+        (void) 0;  // There is enough room without evicting anything.
+    }
+    else if (CanardTxOverflowDropOldest == ins->_tx_slab->policy)
+    {
+        // Every enqueued transfer can be dropped, but not the frames popped and still held by the application.
+        available += ins->_tx_slab->queued_count;
+    }
+    else if ((CanardTxOverflowDropLowestPriority == ins->_tx_slab->policy) && (ins->_tx_queue_root != NULL))
+    {
+        // Count the enqueued frames of lower priority, starting from the lowest, until there are enough.
+        CanardInternalTreeNode* node = ins->_tx_queue_root;
+        while (node->lr[1] != NULL)
+        {
+            node = node->lr[1];
+        }
+        while ((node != NULL) && (available < frame_count) &&
+               (txItemFromPriorityNode(node)->frame.extended_can_id > can_id))
+        {
+            ++available;
+            node = treeNeighbor(node, false);
+        }
+    }
+    else
+    {
+        (void) 0;  // Nothing can be evicted.
+    }
+    return available >= frame_count;
+}
+
+CANARD_PRIVATE CanardInternalTxQueueItem* txAllocateQueueItem(CanardInstance* const   ins,
+                                                              const uint32_t          id,
+                                                              const CanardMicrosecond deadline_usec,
+                                                              const size_t            payload_size);
+CANARD_PRIVATE CanardInternalTxQueueItem* txAllocateQueueItem(CanardInstance* const   ins,
+                                                              const uint32_t          id,
+                                                              const CanardMicrosecond deadline_usec,
+                                                              const size_t            payload_size)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(payload_size > 0U);
+    CanardInternalTxQueueItem* out = NULL;
+    if (ins->_tx_slab != NULL)
+    {
+        CANARD_ASSERT(payload_size <= CANARD_MTU_CAN_FD);  // Every slot can accommodate the largest frame.
+        // The frames of the transfer being constructed are not in the queue yet, so they cannot be evicted.
+        while ((NULL == ins->_tx_slab->free_list) && txSlabEvict(ins, id))
+        {
+            CANARD_ASSERT(ins->_tx_slab->free_count > 0U);
+        }
+        CanardInternalTxSlabSlot* const slot = ins->_tx_slab->free_list;
+        if (slot != NULL)
+        {
+            ins->_tx_slab->free_list = slot->older;
+            ins->_tx_slab->free_count--;
+            out = txItemFromSlot(slot);
+        }
+    }
+    else
+    {
+        out = (CanardInternalTxQueueItem*) ins->memory_allocate(ins, sizeof(CanardInternalTxQueueItem) + payload_size);
+    }
+    if (out != NULL)
+    {
+        out->next                  = NULL;
+        out->frame.timestamp_usec  = deadline_usec;
+        out->frame.payload_size    = payload_size;
+        out->frame.payload         = out->payload_buffer;
+        out->frame.extended_can_id = id;
+    }
+    return out;
+}
+
+/// Returns the number of frames enqueued or error (i.e., =1 or <0).
+CANARD_PRIVATE int32_t txPushSingleFrame(CanardInstance* const   ins,
+                                         const CanardMicrosecond deadline_usec,
+                                         const uint32_t          can_id,
+                                         const CanardTransferID  transfer_id,
+                                         const size_t            payload_size,
+                                         const void* const       payload);
+CANARD_PRIVATE int32_t txPushSingleFrame(CanardInstance* const   ins,
+                                         const CanardMicrosecond deadline_usec,
+                                         const uint32_t          can_id,
+                                         const CanardTransferID  transfer_id,
+                                         const size_t            payload_size,
+                                         const void* const       payload)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT((payload != NULL) || (payload_size == 0));
+
+    const size_t frame_payload_size = txRoundFramePayloadSizeUp(payload_size + 1U);
+    CANARD_ASSERT(frame_payload_size > payload_size);
+    const size_t padding_size = frame_payload_size - payload_size - 1U;
+    CANARD_ASSERT((padding_size + payload_size + 1U) == frame_payload_size);
+    int32_t out = 0;
+
+    CanardInternalTxQueueItem* const tqi = txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size);
+    if (tqi != NULL)
+    {
+        if (payload_size > 0U)  // The check is needed to avoid calling memcpy() with a NULL pointer, it's an UB.
+        {
+            CANARD_ASSERT(payload != NULL);
+            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+            (void) memcpy(&tqi->payload_buffer[0], payload, payload_size);  // NOLINT
+        }
+
+        // Clang-Tidy raises an error recommending the use of memset_s() instead.
+        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+        (void) memset(&tqi->payload_buffer[payload_size], PADDING_BYTE_VALUE, padding_size);  // NOLINT
+
+        tqi->payload_buffer[frame_payload_size - 1U] = txMakeTailByte(true, true, true, transfer_id);
+        txQueueInsert(ins, tqi);
+        out = 1;  // One frame enqueued.
+    }
+    else
+    {
+        out = -CANARD_ERROR_OUT_OF_MEMORY;
+    }
+    CANARD_ASSERT((out < 0) || (out == 1));
+    return out;
+}
+
+/// Returns the number of frames enqueued or error.
+CANARD_PRIVATE int32_t txPushMultiFrame(CanardInstance* const   ins,
                                         const size_t            presentation_layer_mtu,
                                         const CanardMicrosecond deadline_usec,
                                         const uint32_t          can_id,
@@ -475,16 +1404,12 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardInstance* const   ins,
     {
         CANARD_ASSERT(head->next != NULL);  // This is not a single-frame transfer so at least two frames shall exist.
         CANARD_ASSERT(tail->next == NULL);  // The list shall be properly terminated.
-        CanardInternalTxQueueItem* const sup = txFindQueueSupremum(ins, can_id);
-        if (NULL == sup)  // Once the insertion point is located, we insert the entire frame sequence in constant time.
-        {
-            tail->next     = ins->_tx_queue;
-            ins->_tx_queue = head;
-        }
-        else
+        // Equal CAN IDs are inserted after the existing ones, so the frames of the transfer remain contiguous.
+        while (head != NULL)
         {
-            tail->next = sup->next;
-            sup->next  = head;
+            CanardInternalTxQueueItem* const next = head->next;
+            txQueueInsert(ins, head);
+            head = next;
         }
     }
     else  // Failed to allocate at least one frame in the queue! Remove all frames and abort.
@@ -493,7 +1418,7 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardInstance* const   ins,
         while (head != NULL)
         {
             CanardInternalTxQueueItem* const next = head->next;
-            ins->memory_free(ins, head);
+            txFreeQueueItem(ins, head);
             head = next;
         }
     }
@@ -502,6 +1427,62 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardInstance* const   ins,
     return out;
 }
 
+/// Returns the number of frames enqueued or error. This is the implementation of canardTxPush(); the presentation
+/// layer MTU is supplied by the caller so that it is computed once per batch rather than once per transfer.
+CANARD_PRIVATE int32_t txPush(CanardInstance* const ins, const CanardTransfer* const transfer, const size_t pl_mtu);
+CANARD_PRIVATE int32_t txPush(CanardInstance* const ins, const CanardTransfer* const transfer, const size_t pl_mtu)
+{
+    CANARD_ASSERT(ins != NULL);
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((transfer != NULL) && ((transfer->payload != NULL) || (0U == transfer->payload_size)))
+    {
+        const int32_t maybe_can_id = txMakeCANID(transfer, ins->node_id, pl_mtu);
+        const size_t  frame_count  = (transfer->payload_size <= pl_mtu)
+                                         ? 1U
+                                         : (((transfer->payload_size + CRC_SIZE_BYTES) + pl_mtu) - 1U) / pl_mtu;
+        if ((maybe_can_id >= 0) && (ins->_tx_slab != NULL) &&
+            !txSlabCanAccommodate(ins, (uint32_t) maybe_can_id, frame_count))
+        {
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+        else if (maybe_can_id >= 0)
+        {
+            if (transfer->payload_size <= pl_mtu)
+            {
+                out = txPushSingleFrame(ins,
+                                        transfer->timestamp_usec,
+                                        (uint32_t) maybe_can_id,
+                                        transfer->transfer_id,
+                                        transfer->payload_size,
+                                        transfer->payload);
+            }
+            else
+            {
+                out = txPushMultiFrame(ins,
+                                       pl_mtu,
+                                       transfer->timestamp_usec,
+                                       (uint32_t) maybe_can_id,
+                                       transfer->transfer_id,
+                                       transfer->payload_size,
+                                       transfer->payload);
+            }
+        }
+        else
+        {
+            out = maybe_can_id;
+        }
+    }
+    return out;
+}
+
+/// Adds the frames of one transfer to the total of a batch. The total saturates at INT32_MAX instead of overflowing.
+CANARD_PRIVATE int32_t txAddFrameCount(const int32_t total, const int32_t frame_count);
+CANARD_PRIVATE int32_t txAddFrameCount(const int32_t total, const int32_t frame_count)
+{
+    CANARD_ASSERT((total >= 0) && (frame_count > 0));
+    return (frame_count > (INT32_MAX - total)) ? INT32_MAX : (total + frame_count);
+}
+
 // --------------------------------------------- RECEPTION ---------------------------------------------
 
 #define RX_SESSIONS_PER_SUBSCRIPTION (CANARD_NODE_ID_MAX + 1U)
@@ -521,8 +1502,221 @@ typedef struct CanardInternalRxSession
     CanardTransferID  transfer_id;
     uint8_t           redundant_transport_index;  ///< Arbitrary value in [0, 255].
     bool              toggle;
+    bool              payload_retained;  ///< The payload buffer belongs to the session and is only lent out.
 } CanardInternalRxSession;
 
+// A slot of a caller-provided session pool (see canardRxSubscribeWithPool()) contains a session instance followed by
+// its payload buffer of the extent size. The slots are handed out in the order of their addresses and they are never
+// returned because sessions are not destroyed until the subscription is terminated.
+#define RX_SESSION_POOL_ALIGNMENT TX_SLAB_ALIGNMENT
+#define RX_SESSION_POOL_ALIGN_UP(x) ((((x) + RX_SESSION_POOL_ALIGNMENT) - 1U) & ~(RX_SESSION_POOL_ALIGNMENT - 1U))
+#define RX_SESSION_POOL_HEADER_SIZE RX_SESSION_POOL_ALIGN_UP(sizeof(CanardInternalRxSession))
+#define RX_SESSION_POOL_SLOT_SIZE(extent) (RX_SESSION_POOL_HEADER_SIZE + RX_SESSION_POOL_ALIGN_UP(extent))
+
+// The session container of a subscription maps the remote node-ID to the RX session state. By default, it is a
+// table of pointers indexed by node-ID directly. If CANARD_CONFIG_SPARSE_RX_SESSIONS is enabled, it is a bitmap of
+// the node-IDs that have a session plus a dense array of session pointers sorted by node-ID, which is allocated
+// dynamically and grows as needed; the index of a session in the dense array is the number of bits set in the bitmap
+// below its node-ID. Both variants provide constant-time look-up; the sparse one trades a small constant overhead for
+// a much smaller subscription instance.
+
+CANARD_PRIVATE uint8_t rxPopCount(const uint32_t x);
+CANARD_PRIVATE uint8_t rxPopCount(const uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t) __builtin_popcount(x);
+#else
+    uint32_t v = x - ((x >> 1U) & 0x55555555UL);
+    v          = (v & 0x33333333UL) + ((v >> 2U) & 0x33333333UL);
+    return (uint8_t)((((v + (v >> 4U)) & 0x0F0F0F0FUL) * 0x01010101UL) >> 24U);
+#endif
+}
+
+#if CANARD_CONFIG_SPARSE_RX_SESSIONS
+
+#    define RX_SESSION_MASK_WORD_BITS 32U
+#    define RX_SESSION_ARRAY_CAPACITY_MIN 4U
+
+/// Returns the number of sessions whose node-ID is less than the argument, i.e., the position in the dense array.
+CANARD_PRIVATE uint8_t rxSessionRank(const CanardRxSubscription* const sub, const CanardNodeID node_id);
+CANARD_PRIVATE uint8_t rxSessionRank(const CanardRxSubscription* const sub, const CanardNodeID node_id)
+{
+    CANARD_ASSERT(sub != NULL);
+    CANARD_ASSERT(node_id <= RX_SESSIONS_PER_SUBSCRIPTION);
+    const size_t word = node_id / RX_SESSION_MASK_WORD_BITS;
+    const size_t bit  = node_id % RX_SESSION_MASK_WORD_BITS;
+    uint8_t      out  = 0U;
+    for (size_t i = 0; i < word; i++)  // At most four iterations.
+    {
+        out = (uint8_t)(out + rxPopCount(sub->_session_mask[i]));
+    }
+    if (bit > 0U)
+    {
+        out = (uint8_t)(out + rxPopCount(sub->_session_mask[word] & ((UINT32_C(1) << bit) - 1U)));
+    }
+    return out;
+}
+
+CANARD_PRIVATE CanardInternalRxSession* rxSessionFind(const CanardRxSubscription* const sub,
+                                                      const CanardNodeID                node_id);
+CANARD_PRIVATE CanardInternalRxSession* rxSessionFind(const CanardRxSubscription* const sub,
+                                                      const CanardNodeID                node_id)
+{
+    CANARD_ASSERT(sub != NULL);
+    CANARD_ASSERT(node_id <= CANARD_NODE_ID_MAX);
+    CanardInternalRxSession* out  = NULL;
+    const uint32_t           mask = UINT32_C(1) << (node_id % RX_SESSION_MASK_WORD_BITS);
+    if ((sub->_session_mask[node_id / RX_SESSION_MASK_WORD_BITS] & mask) != 0U)
+    {
+        out = sub->_sessions[rxSessionRank(sub, node_id)];
+        CANARD_ASSERT(out != NULL);
+    }
+    return out;
+}
+
+/// Returns falsity if the dense array could not be expanded due to the lack of memory.
+CANARD_PRIVATE bool rxSessionInsert(CanardInstance* const          ins,
+                                    CanardRxSubscription* const    sub,
+                                    const CanardNodeID             node_id,
+                                    CanardInternalRxSession* const rxs);
+CANARD_PRIVATE bool rxSessionInsert(CanardInstance* const          ins,
+                                    CanardRxSubscription* const    sub,
+                                    const CanardNodeID             node_id,
+                                    CanardInternalRxSession* const rxs)
+{
+    CANARD_ASSERT((ins != NULL) && (sub != NULL) && (rxs != NULL));
+    CANARD_ASSERT(NULL == rxSessionFind(sub, node_id));
+    const size_t count = rxSessionRank(sub, RX_SESSIONS_PER_SUBSCRIPTION);
+    CANARD_ASSERT(count <= sub->_session_capacity);
+    bool ok = true;
+    if (count == sub->_session_capacity)
+    {
+        CANARD_ASSERT(NULL == sub->_session_pool);  // The array of a pooled subscription accommodates all slots.
+        size_t capacity = (count < RX_SESSION_ARRAY_CAPACITY_MIN) ? RX_SESSION_ARRAY_CAPACITY_MIN : (count * 2U);
+        if (capacity > RX_SESSIONS_PER_SUBSCRIPTION)
+        {
+            capacity = RX_SESSIONS_PER_SUBSCRIPTION;
+        }
+        CanardInternalRxSession** const arr =
+            (CanardInternalRxSession**) ins->memory_allocate(ins, capacity * sizeof(CanardInternalRxSession*));
+        if (arr != NULL)
+        {
+            if (count > 0U)
+            {
+                // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+                // We ignore it because the safe functions are poorly supported; reliance on them may limit
+                // the portability.
+                (void) memcpy(arr, sub->_sessions, count * sizeof(CanardInternalRxSession*));  // NOLINT
+            }
+            ins->memory_free(ins, (void*) sub->_sessions);
+            sub->_sessions         = arr;
+            sub->_session_capacity = (uint8_t) capacity;
+        }
+        else
+        {
+            ok = false;
+        }
+    }
+    if (ok)
+    {
+        const size_t rank = rxSessionRank(sub, node_id);
+        for (size_t i = count; i > rank; i--)  // Keep the array sorted by node-ID. Only done once per remote node.
+        {
+            sub->_sessions[i] = sub->_sessions[i - 1U];
+        }
+        sub->_sessions[rank] = rxs;
+        sub->_session_mask[node_id / RX_SESSION_MASK_WORD_BITS] |= UINT32_C(1) << (node_id % RX_SESSION_MASK_WORD_BITS);
+    }
+    return ok;
+}
+
+CANARD_PRIVATE void rxSessionsInit(CanardRxSubscription* const sub);
+CANARD_PRIVATE void rxSessionsInit(CanardRxSubscription* const sub)
+{
+    CANARD_ASSERT(sub != NULL);
+    for (size_t i = 0; i < (sizeof(sub->_session_mask) / sizeof(sub->_session_mask[0])); i++)
+    {
+        sub->_session_mask[i] = 0U;
+    }
+    sub->_sessions         = NULL;
+    sub->_session_capacity = 0U;
+}
+
+/// Frees the live sessions along with their payload buffers and the container itself unless they are pooled.
+CANARD_PRIVATE void rxSessionsDestroy(CanardInstance* const ins, CanardRxSubscription* const sub);
+CANARD_PRIVATE void rxSessionsDestroy(CanardInstance* const ins, CanardRxSubscription* const sub)
+{
+    CANARD_ASSERT((ins != NULL) && (sub != NULL));
+    if (NULL == sub->_session_pool)  // Pooled sessions and their dense array reside in the caller-provided storage.
+    {
+        const size_t count = rxSessionRank(sub, RX_SESSIONS_PER_SUBSCRIPTION);
+        for (size_t i = 0; i < count; i++)
+        {
+            ins->memory_free(ins, sub->_sessions[i]->payload);
+            ins->memory_free(ins, sub->_sessions[i]);
+        }
+        ins->memory_free(ins, (void*) sub->_sessions);
+    }
+    rxSessionsInit(sub);
+}
+
+#else
+
+CANARD_PRIVATE CanardInternalRxSession* rxSessionFind(const CanardRxSubscription* const sub,
+                                                      const CanardNodeID                node_id);
+CANARD_PRIVATE CanardInternalRxSession* rxSessionFind(const CanardRxSubscription* const sub,
+                                                      const CanardNodeID                node_id)
+{
+    CANARD_ASSERT(sub != NULL);
+    CANARD_ASSERT(node_id <= CANARD_NODE_ID_MAX);
+    return sub->_sessions[node_id];
+}
+
+/// Returns falsity if the container could not accommodate the session; never happens with this container.
+CANARD_PRIVATE bool rxSessionInsert(CanardInstance* const          ins,
+                                    CanardRxSubscription* const    sub,
+                                    const CanardNodeID             node_id,
+                                    CanardInternalRxSession* const rxs);
+CANARD_PRIVATE bool rxSessionInsert(CanardInstance* const          ins,
+                                    CanardRxSubscription* const    sub,
+                                    const CanardNodeID             node_id,
+                                    CanardInternalRxSession* const rxs)
+{
+    CANARD_ASSERT((ins != NULL) && (sub != NULL) && (rxs != NULL));
+    CANARD_ASSERT(NULL == sub->_sessions[node_id]);
+    (void) ins;
+    sub->_sessions[node_id] = rxs;
+    return true;
+}
+
+CANARD_PRIVATE void rxSessionsInit(CanardRxSubscription* const sub);
+CANARD_PRIVATE void rxSessionsInit(CanardRxSubscription* const sub)
+{
+    CANARD_ASSERT(sub != NULL);
+    for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+    {
+        sub->_sessions[i] = NULL;
+    }
+}
+
+/// Frees the sessions along with their payload buffers unless they are pooled.
+CANARD_PRIVATE void rxSessionsDestroy(CanardInstance* const ins, CanardRxSubscription* const sub);
+CANARD_PRIVATE void rxSessionsDestroy(CanardInstance* const ins, CanardRxSubscription* const sub)
+{
+    CANARD_ASSERT((ins != NULL) && (sub != NULL));
+    if (NULL == sub->_session_pool)  // Pooled sessions reside in the caller-provided storage.
+    {
+        for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+        {
+            ins->memory_free(ins, (sub->_sessions[i] != NULL) ? sub->_sessions[i]->payload : NULL);
+            ins->memory_free(ins, sub->_sessions[i]);
+        }
+    }
+    rxSessionsInit(sub);
+}
+
+#endif
+
 /// High-level transport frame model.
 typedef struct
 {
@@ -618,7 +1812,8 @@ CANARD_PRIVATE void rxInitTransferFromFrame(const RxFrameModel* const frame, Can
     out_transfer->port_id        = frame->port_id;
     out_transfer->remote_node_id = frame->source_node_id;
     out_transfer->transfer_id    = frame->transfer_id;
-    // Payload not populated.
+    // Payload not populated; it is not lent to the application unless the caller says otherwise.
+    out_transfer->payload_buffer_size = 0U;
 }
 
 /// The implementation is borrowed from the Specification.
@@ -636,20 +1831,59 @@ CANARD_PRIVATE uint8_t rxComputeTransferIDDifference(const uint8_t a, const uint
     return (uint8_t) diff;
 }
 
+// Payload buffers of completed transfers may be returned by the application via canardRxReleasePayload(); they are
+// kept in a per-subscription free list (linked through the first bytes of each buffer) for reuse by subsequent
+// transfers of the same subscription, which takes the memory manager off the hot path once the traffic is steady.
+// For this to work, each buffer has the full extent size regardless of the size of the transfer it carries.
+#define RX_PAYLOAD_BUFFER_SIZE(extent) (((extent) > sizeof(void*)) ? (extent) : sizeof(void*))
+
+/// Takes a payload buffer from the free list of the subscription if it is not empty, otherwise allocates a new one.
+CANARD_PRIVATE void* rxPayloadAllocate(CanardInstance* const ins, CanardRxSubscription* const subscription);
+CANARD_PRIVATE void* rxPayloadAllocate(CanardInstance* const ins, CanardRxSubscription* const subscription)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL));
+    void* out = subscription->_payload_free_list;
+    if (out != NULL)
+    {
+        subscription->_payload_free_list = *(void**) out;
+        subscription->_payload_pool_hits++;
+    }
+    else
+    {
+        out = ins->memory_allocate(ins, RX_PAYLOAD_BUFFER_SIZE(subscription->_extent));
+        subscription->_payload_pool_misses++;
+    }
+    return out;
+}
+
+/// Puts the payload buffer into the free list of the subscription. NULL is ignored.
+CANARD_PRIVATE void rxPayloadRecycle(CanardRxSubscription* const subscription, void* const payload);
+CANARD_PRIVATE void rxPayloadRecycle(CanardRxSubscription* const subscription, void* const payload)
+{
+    CANARD_ASSERT(subscription != NULL);
+    if (payload != NULL)
+    {
+        *(void**) payload                = subscription->_payload_free_list;
+        subscription->_payload_free_list = payload;
+    }
+}
+
 CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
+                                            CanardRxSubscription* const    subscription,
                                             CanardInternalRxSession* const rxs,
-                                            const size_t                   extent,
                                             const size_t                   payload_size,
                                             const void* const              payload);
 CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
+                                            CanardRxSubscription* const    subscription,
                                             CanardInternalRxSession* const rxs,
-                                            const size_t                   extent,
                                             const size_t                   payload_size,
                                             const void* const              payload)
 {
     CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(rxs != NULL);
     CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
+    const size_t extent = subscription->_extent;
     CANARD_ASSERT(rxs->payload_size <= extent);  // This invariant is enforced by the subscription logic.
     CANARD_ASSERT(rxs->payload_size <= rxs->total_payload_size);
 
@@ -659,7 +1893,7 @@ CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
     if ((NULL == rxs->payload) && (extent > 0U))
     {
         CANARD_ASSERT(rxs->payload_size == 0);
-        rxs->payload = ins->memory_allocate(ins, extent);
+        rxs->payload = (uint8_t*) rxPayloadAllocate(ins, subscription);
     }
 
     int8_t out = 0;
@@ -693,15 +1927,23 @@ CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
     return out;
 }
 
-CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRxSession* const rxs);
-CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+CANARD_PRIVATE void rxSessionRestart(CanardInstance* const          ins,
+                                     CanardRxSubscription* const    subscription,
+                                     CanardInternalRxSession* const rxs);
+CANARD_PRIVATE void rxSessionRestart(CanardInstance* const          ins,
+                                     CanardRxSubscription* const    subscription,
+                                     CanardInternalRxSession* const rxs)
 {
     CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(rxs != NULL);
-    ins->memory_free(ins, rxs->payload);  // May be NULL, which is OK.
+    if (!rxs->payload_retained)
+    {
+        rxPayloadRecycle(subscription, rxs->payload);  // May be NULL, which is OK.
+        rxs->payload = NULL;
+    }
     rxs->total_payload_size = 0U;
     rxs->payload_size       = 0U;
-    rxs->payload            = NULL;
     rxs->calculated_crc     = CRC_INITIAL;
     rxs->transfer_id        = (CanardTransferID)((rxs->transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
     // The transport index is retained.
@@ -709,22 +1951,24 @@ CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRx
 }
 
 CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
+                                           CanardRxSubscription* const    subscription,
                                            CanardInternalRxSession* const rxs,
                                            const RxFrameModel* const      frame,
-                                           const size_t                   extent,
                                            CanardTransfer* const          out_transfer);
 CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
+                                           CanardRxSubscription* const    subscription,
                                            CanardInternalRxSession* const rxs,
                                            const RxFrameModel* const      frame,
-                                           const size_t                   extent,
                                            CanardTransfer* const          out_transfer)
 {
     CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(rxs != NULL);
     CANARD_ASSERT(frame != NULL);
     CANARD_ASSERT(frame->payload != NULL);
     CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
     CANARD_ASSERT(out_transfer != NULL);
+    const size_t extent = subscription->_extent;
 
     if (frame->start_of_transfer)  // The transfer timestamp is the timestamp of its first frame.
     {
@@ -739,11 +1983,14 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
         rxs->calculated_crc = crcAdd(rxs->calculated_crc, frame->payload_size, frame->payload);
     }
 
-    int8_t out = rxSessionWritePayload(ins, rxs, extent, frame->payload_size, frame->payload);
+    // In the zero-copy mode, the payload of a single-frame transfer is referenced in the frame buffer supplied by the
+    // application instead of being copied into the session payload buffer.
+    const bool copy = !(single_frame && subscription->_zero_copy);
+    int8_t     out  = copy ? rxSessionWritePayload(ins, subscription, rxs, frame->payload_size, frame->payload) : 0;
     if (out < 0)
     {
         CANARD_ASSERT(-CANARD_ERROR_OUT_OF_MEMORY == out);
-        rxSessionRestart(ins, rxs);  // Out-of-memory.
+        rxSessionRestart(ins, subscription, rxs);  // Out-of-memory.
     }
     else if (frame->end_of_transfer)
     {
@@ -753,8 +2000,16 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
             out = 1;  // One transfer received, notify the application.
             rxInitTransferFromFrame(frame, out_transfer);
             out_transfer->timestamp_usec = rxs->transfer_timestamp_usec;
-            out_transfer->payload_size   = rxs->payload_size;
-            out_transfer->payload        = rxs->payload;
+            if (copy)
+            {
+                out_transfer->payload_size = rxs->payload_size;
+                out_transfer->payload      = rxs->payload;
+            }
+            else
+            {
+                out_transfer->payload_size = (extent < frame->payload_size) ? extent : frame->payload_size;
+                out_transfer->payload      = frame->payload;
+            }
 
             // Cut off the CRC from the payload if it's there -- we don't want to expose it to the user.
             CANARD_ASSERT(rxs->total_payload_size >= rxs->payload_size);
@@ -765,9 +2020,14 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
                 out_transfer->payload_size -= CRC_SIZE_BYTES - truncated_amount;
             }
 
-            rxs->payload = NULL;  // Ownership passed over to the application, nullify to prevent freeing.
+            if (copy && (!rxs->payload_retained))
+            {
+                // Ownership passed over to the application, nullify to prevent freeing.
+                out_transfer->payload_buffer_size = (rxs->payload != NULL) ? RX_PAYLOAD_BUFFER_SIZE(extent) : 0U;
+                rxs->payload                      = NULL;
+            }
         }
-        rxSessionRestart(ins, rxs);  // Successful completion.
+        rxSessionRestart(ins, subscription, rxs);  // Successful completion.
     }
     else
     {
@@ -784,28 +2044,28 @@ CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
 /// advantageous because it allows implementers to choose whatever solution works best for the specific application at
 /// hand, while the wire compatibility is still guaranteed by the high-level requirements given in the specification.
 CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
+                                      CanardRxSubscription* const    subscription,
                                       CanardInternalRxSession* const rxs,
                                       const RxFrameModel* const      frame,
                                       const uint8_t                  redundant_transport_index,
-                                      const CanardMicrosecond        transfer_id_timeout_usec,
-                                      const size_t                   extent,
                                       CanardTransfer* const          out_transfer);
 CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
+                                      CanardRxSubscription* const    subscription,
                                       CanardInternalRxSession* const rxs,
                                       const RxFrameModel* const      frame,
                                       const uint8_t                  redundant_transport_index,
-                                      const CanardMicrosecond        transfer_id_timeout_usec,
-                                      const size_t                   extent,
                                       CanardTransfer* const          out_transfer)
 {
     CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(rxs != NULL);
     CANARD_ASSERT(frame != NULL);
     CANARD_ASSERT(out_transfer != NULL);
     CANARD_ASSERT(rxs->transfer_id <= CANARD_TRANSFER_ID_MAX);
     CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
 
-    const bool tid_timed_out = (frame->timestamp_usec > rxs->transfer_timestamp_usec) &&
+    const CanardMicrosecond transfer_id_timeout_usec = subscription->_transfer_id_timeout_usec;
+    const bool              tid_timed_out            = (frame->timestamp_usec > rxs->transfer_timestamp_usec) &&
                                ((frame->timestamp_usec - rxs->transfer_timestamp_usec) > transfer_id_timeout_usec);
 
     const bool not_previous_tid = rxComputeTransferIDDifference(rxs->transfer_id, frame->transfer_id) > 1;
@@ -826,7 +2086,7 @@ CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
     int8_t out = 0;
     if (need_restart && (!frame->start_of_transfer))
     {
-        rxSessionRestart(ins, rxs);  // SOT-miss, no point going further.
+        rxSessionRestart(ins, subscription, rxs);  // SOT-miss, no point going further.
     }
     else
     {
@@ -835,24 +2095,56 @@ CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
         const bool correct_tid       = (frame->transfer_id == rxs->transfer_id);
         if (correct_transport && correct_toggle && correct_tid)
         {
-            out = rxSessionAcceptFrame(ins, rxs, frame, extent, out_transfer);
+            out = rxSessionAcceptFrame(ins, subscription, rxs, frame, out_transfer);
         }
     }
     return out;
 }
 
-CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
-                                    CanardRxSubscription* const subscription,
-                                    const RxFrameModel* const   frame,
-                                    const uint8_t               redundant_transport_index,
-                                    CanardTransfer* const       out_transfer);
-CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
-                                    CanardRxSubscription* const subscription,
-                                    const RxFrameModel* const   frame,
-                                    const uint8_t               redundant_transport_index,
-                                    CanardTransfer* const       out_transfer)
+/// Takes a new session from the pool of the subscription if it has one, otherwise allocates it from the heap.
+/// Only the payload buffer fields are initialized. Returns NULL if the pool is exhausted or the heap is out of memory.
+CANARD_PRIVATE CanardInternalRxSession* rxSessionAllocate(CanardInstance* const ins, CanardRxSubscription* const sub);
+CANARD_PRIVATE CanardInternalRxSession* rxSessionAllocate(CanardInstance* const ins, CanardRxSubscription* const sub)
 {
-    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT((ins != NULL) && (sub != NULL));
+    CanardInternalRxSession* out = NULL;
+    if (NULL == sub->_session_pool)
+    {
+        out = (CanardInternalRxSession*) ins->memory_allocate(ins, sizeof(CanardInternalRxSession));
+        if (out != NULL)
+        {
+            out->payload          = NULL;  // Allocated lazily.
+            out->payload_retained = false;
+        }
+    }
+    else if (sub->_session_pool_free > 0U)
+    {
+        out = (CanardInternalRxSession*) (void*) sub->_session_pool;
+        // Intentional violation of MISRA: indexing on a pointer. The slot size is only known at runtime.
+        out->payload          = (sub->_extent > 0U) ? &sub->_session_pool[RX_SESSION_POOL_HEADER_SIZE] : NULL;
+        out->payload_retained = true;
+        sub->_session_pool    = &sub->_session_pool[RX_SESSION_POOL_SLOT_SIZE(sub->_extent)];
+        sub->_session_pool_free--;
+    }
+    else
+    {
+        (void) 0;  // The pool is exhausted; the remote node cannot be served.
+    }
+    return out;
+}
+
+CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
+                                    CanardRxSubscription* const subscription,
+                                    const RxFrameModel* const   frame,
+                                    const uint8_t               redundant_transport_index,
+                                    CanardTransfer* const       out_transfer);
+CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
+                                    CanardRxSubscription* const subscription,
+                                    const RxFrameModel* const   frame,
+                                    const uint8_t               redundant_transport_index,
+                                    CanardTransfer* const       out_transfer)
+{
+    CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(subscription != NULL);
     CANARD_ASSERT(subscription->_port_id == frame->port_id);
     CANARD_ASSERT(frame != NULL);
@@ -866,62 +2158,281 @@ CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
     {
         // If such session does not exist, create it. This only makes sense if this is the first frame of a
         // transfer, otherwise, we won't be able to receive the transfer anyway so we don't bother.
-        if ((NULL == subscription->_sessions[frame->source_node_id]) && frame->start_of_transfer)
+        CanardInternalRxSession* rxs = rxSessionFind(subscription, frame->source_node_id);
+        if ((NULL == rxs) && frame->start_of_transfer)
         {
-            CanardInternalRxSession* const rxs =
-                (CanardInternalRxSession*) ins->memory_allocate(ins, sizeof(CanardInternalRxSession));
-            subscription->_sessions[frame->source_node_id] = rxs;
+            rxs = rxSessionAllocate(ins, subscription);
             if (rxs != NULL)
             {
                 rxs->transfer_timestamp_usec   = frame->timestamp_usec;
                 rxs->total_payload_size        = 0U;
                 rxs->payload_size              = 0U;
-                rxs->payload                   = NULL;
                 rxs->calculated_crc            = CRC_INITIAL;
                 rxs->transfer_id               = frame->transfer_id;
                 rxs->redundant_transport_index = redundant_transport_index;
                 rxs->toggle                    = INITIAL_TOGGLE_STATE;
+                if (!rxSessionInsert(ins, subscription, frame->source_node_id, rxs))
+                {
+                    CANARD_ASSERT(!rxs->payload_retained);  // Pooled sessions never require container expansion.
+                    ins->memory_free(ins, rxs);
+                    rxs = NULL;
+                }
             }
-            else
+            if ((NULL == rxs) && (NULL == subscription->_session_pool))  // Pool exhaustion is not an error.
             {
                 out = -CANARD_ERROR_OUT_OF_MEMORY;
             }
         }
-        // There are two possible reasons why the session may not exist: 1. OOM; 2. SOT-miss.
-        if (subscription->_sessions[frame->source_node_id] != NULL)
+        // There are three possible reasons why the session may not exist: 1. OOM; 2. pool exhaustion; 3. SOT-miss.
+        if (rxs != NULL)
         {
             CANARD_ASSERT(out == 0);
-            out = rxSessionUpdate(ins,
-                                  subscription->_sessions[frame->source_node_id],
-                                  frame,
-                                  redundant_transport_index,
-                                  subscription->_transfer_id_timeout_usec,
-                                  subscription->_extent,
-                                  out_transfer);
+            out = rxSessionUpdate(ins, subscription, rxs, frame, redundant_transport_index, out_transfer);
         }
     }
     else
     {
         CANARD_ASSERT(frame->source_node_id == CANARD_NODE_ID_UNSET);
         // Anonymous transfers are stateless. No need to update the state machine, just blindly accept it.
-        // We have to copy the data into an allocated storage because the API expects it: the lifetime shall be
-        // independent of the input data and the memory shall be free-able.
+        // Unless zero-copy delivery is enabled, we have to copy the data into an allocated storage because the API
+        // expects it: the lifetime shall be independent of the input data and the memory shall be free-able.
         const size_t payload_size =
             (subscription->_extent < frame->payload_size) ? subscription->_extent : frame->payload_size;
-        void* const payload = ins->memory_allocate(ins, payload_size);
-        if (payload != NULL)
+        // Pooled subscriptions cannot lend a buffer because there is no session, so the frame is referenced instead.
+        if (subscription->_zero_copy || (subscription->_session_pool != NULL))
         {
             rxInitTransferFromFrame(frame, out_transfer);
             out_transfer->payload_size = payload_size;
-            out_transfer->payload      = payload;
-            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            (void) memcpy(payload, frame->payload, payload_size);  // NOLINT
-            out = 1;
+            out_transfer->payload      = frame->payload;
+            out                        = 1;
         }
         else
         {
-            out = -CANARD_ERROR_OUT_OF_MEMORY;
+            void* const payload = rxPayloadAllocate(ins, subscription);
+            if (payload != NULL)
+            {
+                rxInitTransferFromFrame(frame, out_transfer);
+                out_transfer->payload_size        = payload_size;
+                out_transfer->payload             = payload;
+                out_transfer->payload_buffer_size = RX_PAYLOAD_BUFFER_SIZE(subscription->_extent);
+                // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+                // We ignore it because the safe functions are poorly supported; reliance on them may limit the
+                // portability.
+                (void) memcpy(payload, frame->payload, payload_size);  // NOLINT
+                out = 1;
+            }
+            else
+            {
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    return out;
+}
+
+/// Returns the maximum valid port-ID value for the transfer kind, which defines the size of the subscription index.
+CANARD_PRIVATE CanardPortID rxGetPortIDMax(const CanardTransferKind transfer_kind);
+CANARD_PRIVATE CanardPortID rxGetPortIDMax(const CanardTransferKind transfer_kind)
+{
+    return (CanardTransferKindMessage == transfer_kind) ? (CanardPortID) CANARD_SUBJECT_ID_MAX
+                                                        : (CanardPortID) CANARD_SERVICE_ID_MAX;
+}
+
+/// Find the subscription for the specified port. Unless the subscription index is installed for this transfer kind,
+/// this is the reason canardRxAccept() has a linear time complexity from the number of subscriptions. Note also that
+/// this is one of the two variable-complexity operations in the RX pipeline; the other one is memcpy(). Excepting these
+/// two cases, the entire RX pipeline logic contains neither loops nor recursion.
+CANARD_PRIVATE CanardRxSubscription* rxFindSubscription(const CanardInstance* const ins,
+                                                        const CanardTransferKind    transfer_kind,
+                                                        const CanardPortID          port_id);
+CANARD_PRIVATE CanardRxSubscription* rxFindSubscription(const CanardInstance* const ins,
+                                                        const CanardTransferKind    transfer_kind,
+                                                        const CanardPortID          port_id)
+{
+    CANARD_ASSERT(ins != NULL);
+    const size_t          tk  = (size_t) transfer_kind;
+    CanardRxSubscription* out = NULL;
+    CANARD_ASSERT(tk < CANARD_NUM_TRANSFER_KINDS);
+    if (ins->_rx_index[tk] != NULL)
+    {
+        if (port_id <= rxGetPortIDMax(transfer_kind))
+        {
+            out = ins->_rx_index[tk][port_id];
+        }
+    }
+    else
+    {
+        out = ins->_rx_subscriptions[tk];
+        while ((out != NULL) && (out->_port_id != port_id))
+        {
+            out = out->_next;
+        }
+    }
+    CANARD_ASSERT((out == NULL) || (out->_port_id == port_id));
+    return out;
+}
+
+/// Validates and parses the frame and finds the subscription it should be delivered to.
+/// Returns NULL if the frame shall be ignored; this is not an error. The frame pointer shall be valid.
+CANARD_PRIVATE CanardRxSubscription* rxResolveFrame(const CanardInstance* const ins,
+                                                    const CanardFrame* const    frame,
+                                                    RxFrameModel* const         out_model);
+CANARD_PRIVATE CanardRxSubscription* rxResolveFrame(const CanardInstance* const ins,
+                                                    const CanardFrame* const    frame,
+                                                    RxFrameModel* const         out_model)
+{
+    CANARD_ASSERT((ins != NULL) && (frame != NULL) && (out_model != NULL));
+    CanardRxSubscription* out = NULL;
+    if (rxTryParseFrame(frame, out_model))
+    {
+        if ((CANARD_NODE_ID_UNSET == out_model->destination_node_id) ||
+            (ins->node_id == out_model->destination_node_id))
+        {
+            out = rxFindSubscription(ins, out_model->transfer_kind, out_model->port_id);  // May be NULL.
+            CANARD_ASSERT((NULL == out) || (out->_port_id == out_model->port_id));
+        }
+        else
+        {
+            (void) 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
+        }
+    }
+    else
+    {
+        (void) 0;  // A non-UAVCAN/CAN input frame.
+    }
+    return out;
+}
+
+/// The session pool is NULL if the sessions are to be allocated dynamically.
+CANARD_PRIVATE int8_t rxSubscribe(CanardInstance* const       ins,
+                                  const CanardTransferKind    transfer_kind,
+                                  const CanardPortID          port_id,
+                                  const size_t                extent,
+                                  const CanardMicrosecond     transfer_id_timeout_usec,
+                                  uint8_t* const              session_pool,
+                                  const uint8_t               session_pool_size,
+                                  CanardRxSubscription* const out_subscription);
+CANARD_PRIVATE int8_t rxSubscribe(CanardInstance* const       ins,
+                                  const CanardTransferKind    transfer_kind,
+                                  const CanardPortID          port_id,
+                                  const size_t                extent,
+                                  const CanardMicrosecond     transfer_id_timeout_usec,
+                                  uint8_t* const              session_pool,
+                                  const uint8_t               session_pool_size,
+                                  CanardRxSubscription* const out_subscription)
+{
+    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t tk  = (size_t) transfer_kind;
+    if ((ins != NULL) && (out_subscription != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    {
+        // Reset to the initial state. This is absolutely critical because the new payload size limit may be larger
+        // than the old value; if there are any payload buffers allocated, we may overrun them because they are shorter
+        // than the new payload limit. So we clear the subscription and thus ensure that no overrun may occur.
+        out = canardRxUnsubscribe(ins, transfer_kind, port_id);
+        if (out >= 0)
+        {
+            // The sessions will be created ad-hoc, either dynamically or from the caller-provided pool if there is one.
+            rxSessionsInit(out_subscription);
+            out_subscription->_session_pool             = session_pool;
+            out_subscription->_session_pool_free        = session_pool_size;
+            out_subscription->_zero_copy                = false;
+            out_subscription->_payload_free_list        = NULL;
+            out_subscription->_payload_pool_hits        = 0U;
+            out_subscription->_payload_pool_misses      = 0U;
+            out_subscription->_transfer_id_timeout_usec = transfer_id_timeout_usec;
+            out_subscription->_extent                   = extent;
+            out_subscription->_port_id                  = port_id;
+            out_subscription->_next                     = ins->_rx_subscriptions[tk];
+            ins->_rx_subscriptions[tk]                  = out_subscription;
+            if ((ins->_rx_index[tk] != NULL) && (port_id <= rxGetPortIDMax(transfer_kind)))
+            {
+                ins->_rx_index[tk][port_id] = out_subscription;
+            }
+            out = (out > 0) ? 0 : 1;
+        }
+    }
+    return out;
+}
+
+// --------------------------------------------- ACCEPTANCE FILTERS ---------------------------------------------
+
+/// Returns truth if every CAN ID accepted by the inner filter is also accepted by the outer one.
+CANARD_PRIVATE bool rxFilterCovers(const CanardFilter* const outer, const CanardFilter* const inner);
+CANARD_PRIVATE bool rxFilterCovers(const CanardFilter* const outer, const CanardFilter* const inner)
+{
+    return ((outer->extended_mask & inner->extended_mask) == outer->extended_mask) &&
+           (0U == ((outer->extended_can_id ^ inner->extended_can_id) & outer->extended_mask));
+}
+
+/// The number of CAN ID bits checked by the merger of the two filters. The more bits remain, the fewer unwanted frames
+/// pass the merged filter, so the pair with the highest rank is the cheapest one to merge.
+CANARD_PRIVATE uint8_t rxFilterMergeRank(const CanardFilter* const a, const CanardFilter* const b);
+CANARD_PRIVATE uint8_t rxFilterMergeRank(const CanardFilter* const a, const CanardFilter* const b)
+{
+    return rxPopCount(a->extended_mask & b->extended_mask & ~(a->extended_can_id ^ b->extended_can_id));
+}
+
+/// Adds the filter to the set of the specified size, which is not more than the capacity, and returns the new size.
+/// A filter that is covered by one of the set is dropped. If the set is full, either the new filter is merged with one
+/// of the set, or two filters of the set are merged and the new one takes the freed place, whichever keeps more bits.
+CANARD_PRIVATE size_t rxFilterAdd(CanardFilter* const       filters,
+                                  const size_t              size,
+                                  const size_t              capacity,
+                                  const CanardFilter* const filter);
+CANARD_PRIVATE size_t rxFilterAdd(CanardFilter* const       filters,
+                                  const size_t              size,
+                                  const size_t              capacity,
+                                  const CanardFilter* const filter)
+{
+    CANARD_ASSERT((filters != NULL) && (filter != NULL) && (size <= capacity) && (capacity > 0U));
+    size_t out     = size;
+    bool   covered = false;
+    for (size_t i = 0; i < size; i++)
+    {
+        covered = covered || rxFilterCovers(&filters[i], filter);
+    }
+    if (covered)
+    {
+        (void) 0;  // The frames are already accepted, nothing to do.
+    }
+    else if (size < capacity)
+    {
+        filters[size] = *filter;
+        out           = size + 1U;
+    }
+    else
+    {
+        size_t  best_a    = 0U;
+        size_t  best_b    = size;  // The new filter.
+        uint8_t best_rank = rxFilterMergeRank(&filters[0], filter);
+        for (size_t i = 0; i < size; i++)
+        {
+            const uint8_t rank_new = rxFilterMergeRank(&filters[i], filter);
+            if (rank_new > best_rank)
+            {
+                best_a    = i;
+                best_b    = size;
+                best_rank = rank_new;
+            }
+            for (size_t k = i + 1U; k < size; k++)
+            {
+                const uint8_t rank = rxFilterMergeRank(&filters[i], &filters[k]);
+                if (rank > best_rank)
+                {
+                    best_a    = i;
+                    best_b    = k;
+                    best_rank = rank;
+                }
+            }
+        }
+        if (best_b == size)
+        {
+            filters[best_a] = canardConsolidateFilters(&filters[best_a], filter);
+        }
+        else
+        {
+            filters[best_a] = canardConsolidateFilters(&filters[best_a], &filters[best_b]);
+            filters[best_b] = *filter;
         }
     }
     return out;
@@ -953,6 +2464,10 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
         .memory_free       = memory_free,
         ._rx_subscriptions = {NULL, NULL, NULL},
         ._tx_queue         = NULL,
+        ._tx_queue_root    = NULL,
+        ._tx_slab          = NULL,
+        ._tx_deadline_root = NULL,
+        ._rx_index         = {NULL, NULL, NULL},
     };
     return out;
 }
@@ -960,37 +2475,37 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 int32_t canardTxPush(CanardInstance* const ins, const CanardTransfer* const transfer)
 {
     int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
-    if ((ins != NULL) && (transfer != NULL) && ((transfer->payload != NULL) || (0U == transfer->payload_size)))
+    if (ins != NULL)
     {
-        const size_t  pl_mtu       = txGetPresentationLayerMTU(ins);
-        const int32_t maybe_can_id = txMakeCANID(transfer, ins->node_id, pl_mtu);
-        if (maybe_can_id >= 0)
+        out = txPush(ins, transfer, txGetPresentationLayerMTU(ins));
+    }
+    return out;
+}
+
+int32_t canardTxPushBatch(CanardInstance* const       ins,
+                          const CanardTransfer* const transfers,
+                          const size_t                count,
+                          int32_t* const              out_results)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && ((transfers != NULL) || (0U == count)))
+    {
+        out                 = 0;
+        const size_t pl_mtu = txGetPresentationLayerMTU(ins);  // The MTU setting cannot change during the batch.
+        for (size_t i = 0; i < count; i++)
         {
-            if (transfer->payload_size <= pl_mtu)
+            const int32_t res = txPush(ins, &transfers[i], pl_mtu);
+            if (res > 0)
             {
-                out = txPushSingleFrame(ins,
-                                        transfer->timestamp_usec,
-                                        (uint32_t) maybe_can_id,
-                                        transfer->transfer_id,
-                                        transfer->payload_size,
-                                        transfer->payload);
+                out = txAddFrameCount(out, res);
             }
-            else
+            if (out_results != NULL)
             {
-                out = txPushMultiFrame(ins,
-                                       pl_mtu,
-                                       transfer->timestamp_usec,
-                                       (uint32_t) maybe_can_id,
-                                       transfer->transfer_id,
-                                       transfer->payload_size,
-                                       transfer->payload);
+                out_results[i] = res;
             }
         }
-        else
-        {
-            out = maybe_can_id;
-        }
     }
+    CANARD_ASSERT(out >= -CANARD_ERROR_INVALID_ARGUMENT);
     return out;
 }
 
@@ -1016,10 +2531,120 @@ void canardTxPop(CanardInstance* const ins)
     if ((ins != NULL) && (ins->_tx_queue != NULL))
     {
         // The memory is NOT deallocated. The application is responsible for that.
-        ins->_tx_queue = ins->_tx_queue->next;
+        CANARD_ASSERT(NULL == ins->_tx_queue->priority_node.lr[0]);  // The head is always the leftmost node.
+        txQueueRemove(ins, NULL, ins->_tx_queue);
+    }
+}
+
+int32_t canardTxExpire(CanardInstance* const ins, const CanardMicrosecond now_usec, size_t* const out_transfer_count)
+{
+    int32_t out       = -CANARD_ERROR_INVALID_ARGUMENT;
+    size_t  transfers = 0U;
+    if (ins != NULL)
+    {
+        size_t frames = 0U;
+#if CANARD_CONFIG_TX_DEADLINE_INDEX
+        while (ins->_tx_deadline_root != NULL)
+        {
+            CanardInternalTreeNode* node = ins->_tx_deadline_root;
+            while (node->lr[0] != NULL)
+            {
+                node = node->lr[0];
+            }
+            // The earliest item is the first remaining frame of its transfer because the frames of a transfer are
+            // inserted one after another and equal deadlines retain the insertion order.
+            CanardInternalTxQueueItem* const item = txItemFromDeadlineNode(node);
+            if (item->frame.timestamp_usec >= now_usec)
+            {
+                break;
+            }
+            frames += txQueueDropTransfer(ins, item);
+            ++transfers;
+        }
+#else
+        // Without the index, the queue is scanned. The first frame of a transfer met in the queue is its first
+        // remaining frame because the frames of a transfer are contiguous, and they all share the same deadline.
+        const CanardInternalTxQueueItem* prev = NULL;
+        CanardInternalTxQueueItem*       item = ins->_tx_queue;
+        while (item != NULL)
+        {
+            if (item->frame.timestamp_usec < now_usec)
+            {
+                frames += txQueueDropTransfer(ins, item);
+                ++transfers;
+            }
+            else
+            {
+                prev = item;
+            }
+            item = (NULL == prev) ? ins->_tx_queue : prev->next;
+        }
+#endif
+        out = (frames > (size_t) INT32_MAX) ? INT32_MAX : (int32_t) frames;
+    }
+    if (out_transfer_count != NULL)
+    {
+        *out_transfer_count = transfers;
+    }
+    return out;
+}
+
+int32_t canardTxInitSlab(CanardInstance* const        ins,
+                         void* const                  storage,
+                         const size_t                 storage_size,
+                         const CanardTxOverflowPolicy overflow_policy)
+{
+    int32_t      out         = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t header_size = TX_SLAB_ALIGN_UP(sizeof(CanardInternalTxSlab));
+    if ((ins != NULL) && (NULL == ins->_tx_queue) && (NULL == ins->_tx_slab) && (storage != NULL) &&
+        ((((size_t) storage) % TX_SLAB_ALIGNMENT) == 0U) && (storage_size >= (header_size + TX_SLAB_SLOT_SIZE)) &&
+        ((CanardTxOverflowReject == overflow_policy) || (CanardTxOverflowDropLowestPriority == overflow_policy) ||
+         (CanardTxOverflowDropOldest == overflow_policy)))
+    {
+        size_t slot_count = (storage_size - header_size) / TX_SLAB_SLOT_SIZE;
+        if (slot_count > (size_t) INT32_MAX)
+        {
+            slot_count = (size_t) INT32_MAX;
+        }
+        CanardInternalTxSlab* const slab = (CanardInternalTxSlab*) storage;
+        slab->free_list                  = NULL;
+        slab->oldest                     = NULL;
+        slab->newest                     = NULL;
+        slab->slot_count                 = slot_count;
+        slab->free_count                 = slot_count;
+        slab->queued_count               = 0U;
+        slab->policy                     = overflow_policy;
+        // Build the free list such that the slots are handed out in the order of their addresses.
+        uint8_t* const base = ((uint8_t*) storage) + header_size;
+        for (size_t i = slot_count; i > 0U; i--)
+        {
+            // Intentional violation of MISRA: indexing on a pointer. The slot size is only known at runtime.
+            CanardInternalTxSlabSlot* const slot =
+                (CanardInternalTxSlabSlot*) (void*) &base[(i - 1U) * TX_SLAB_SLOT_SIZE];
+            slot->older     = slab->free_list;
+            slot->newer     = NULL;
+            slab->free_list = slot;
+        }
+        ins->_tx_slab = slab;
+        out           = (int32_t) slot_count;
+    }
+    return out;
+}
+
+void canardTxFree(CanardInstance* const ins, const CanardFrame* const frame)
+{
+    if ((ins != NULL) && (frame != NULL))
+    {
+        // The frame is the first member of the queue item, so the conversion is standard-compliant.
+        txFreeQueueItem(ins, (CanardInternalTxQueueItem*) (void*) frame);
     }
 }
 
+size_t canardTxGetItemSize(const size_t payload_size)
+{
+    return sizeof(CanardInternalTxQueueItem) + payload_size;
+}
+
 int8_t canardRxAccept(CanardInstance* const    ins,
                       const CanardFrame* const frame,
                       const uint8_t            redundant_transport_index,
@@ -1029,45 +2654,61 @@ int8_t canardRxAccept(CanardInstance* const    ins,
     if ((ins != NULL) && (out_transfer != NULL) && (frame != NULL) && (frame->extended_can_id <= CAN_EXT_ID_MASK) &&
         ((frame->payload != NULL) || (0 == frame->payload_size)))
     {
-        RxFrameModel model = {0};
-        if (rxTryParseFrame(frame, &model))
+        RxFrameModel                model = {0};
+        CanardRxSubscription* const sub   = rxResolveFrame(ins, frame, &model);
+        if (sub != NULL)
         {
-            if ((CANARD_NODE_ID_UNSET == model.destination_node_id) || (ins->node_id == model.destination_node_id))
-            {
-                // Find subscription. This is the reason the function has a linear time complexity from the number of
-                // subscriptions. Note also that this one of the two variable-complexity operations in the RX pipeline;
-                // the other one is memcpy(). Excepting these two cases, the entire RX pipeline logic contains neither
-                // loops nor recursion.
-                CanardRxSubscription* sub = ins->_rx_subscriptions[(size_t) model.transfer_kind];
-                while ((sub != NULL) && (sub->_port_id != model.port_id))
-                {
-                    sub = sub->_next;
-                }
-
-                if (sub != NULL)
-                {
-                    CANARD_ASSERT(sub->_port_id == model.port_id);
-                    out = rxAcceptFrame(ins, sub, &model, redundant_transport_index, out_transfer);
-                }
-                else
-                {
-                    out = 0;  // No matching subscription.
-                }
-            }
-            else
-            {
-                out = 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
-            }
+            out = rxAcceptFrame(ins, sub, &model, redundant_transport_index, out_transfer);
         }
         else
         {
-            out = 0;  // A non-UAVCAN/CAN input frame.
+            out = 0;  // Not a UAVCAN/CAN frame, mis-addressed, or no matching subscription.
         }
     }
     CANARD_ASSERT(out <= 1);
     return out;
 }
 
+int32_t canardRxAcceptBatch(CanardInstance* const    ins,
+                            const CanardFrame* const frames,
+                            const size_t             count,
+                            const uint8_t            redundant_transport_index,
+                            CanardTransfer* const    out_transfers,
+                            const size_t             out_capacity,
+                            size_t* const            out_frame_count)
+{
+    int32_t out       = -CANARD_ERROR_INVALID_ARGUMENT;
+    size_t  processed = 0U;
+    if ((ins != NULL) && ((count == 0U) || ((frames != NULL) && (out_transfers != NULL))) &&
+        (count <= (size_t) INT32_MAX))
+    {
+        out       = 0;
+        bool lent = false;  // Set once a payload is lent from a pooled session; the processing stops there.
+        // Every frame may complete a transfer, so the processing also stops once the output is full.
+        for (; (processed < count) && (((size_t) out) < out_capacity) && !lent; processed++)
+        {
+            const CanardFrame* const frame = &frames[processed];
+            if ((frame->extended_can_id <= CAN_EXT_ID_MASK) && ((frame->payload != NULL) || (0 == frame->payload_size)))
+            {
+                RxFrameModel                model = {0};
+                CanardRxSubscription* const sub   = rxResolveFrame(ins, frame, &model);
+                if ((sub != NULL) &&
+                    (rxAcceptFrame(ins, sub, &model, redundant_transport_index, &out_transfers[out]) > 0))
+                {
+                    out++;
+                    // The next frame from the same node would overwrite the buffer of the pooled session.
+                    lent = (sub->_session_pool != NULL) && (model.source_node_id <= CANARD_NODE_ID_MAX);
+                }
+            }
+        }
+    }
+    if (out_frame_count != NULL)
+    {
+        *out_frame_count = processed;
+    }
+    return out;
+}
+
 int8_t canardRxSubscribe(CanardInstance* const       ins,
                          const CanardTransferKind    transfer_kind,
                          const CanardPortID          port_id,
@@ -1075,29 +2716,78 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
                          const CanardMicrosecond     transfer_id_timeout_usec,
                          CanardRxSubscription* const out_subscription)
 {
-    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
-    const size_t tk  = (size_t) transfer_kind;
-    if ((ins != NULL) && (out_subscription != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS))
+    return rxSubscribe(ins, transfer_kind, port_id, extent, transfer_id_timeout_usec, NULL, 0U, out_subscription);
+}
+
+size_t canardRxGetSessionPoolSlotSize(const size_t extent)
+{
+    return RX_SESSION_POOL_SLOT_SIZE(extent);
+}
+
+size_t canardRxGetSessionSize(void)
+{
+    return sizeof(CanardInternalRxSession);
+}
+
+size_t canardRxGetPayloadBufferSize(const size_t extent)
+{
+    return RX_PAYLOAD_BUFFER_SIZE(extent);
+}
+
+int8_t canardRxSubscribeWithPool(CanardInstance* const       ins,
+                                 const CanardTransferKind    transfer_kind,
+                                 const CanardPortID          port_id,
+                                 const size_t                extent,
+                                 const CanardMicrosecond     transfer_id_timeout_usec,
+                                 void* const                 storage,
+                                 const size_t                storage_size,
+                                 CanardRxSubscription* const out_subscription)
+{
+    int8_t       out       = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t slot_size = RX_SESSION_POOL_SLOT_SIZE(extent);
+    if ((storage != NULL) && ((((size_t) storage) % RX_SESSION_POOL_ALIGNMENT) == 0U) && (slot_size > extent))
     {
-        // Reset to the initial state. This is absolutely critical because the new payload size limit may be larger
-        // than the old value; if there are any payload buffers allocated, we may overrun them because they are shorter
-        // than the new payload limit. So we clear the subscription and thus ensure that no overrun may occur.
-        out = canardRxUnsubscribe(ins, transfer_kind, port_id);
-        if (out >= 0)
+#if CANARD_CONFIG_SPARSE_RX_SESSIONS
+        // The dense session array is placed at the beginning of the storage, one pointer per slot, so that the
+        // container never needs to be expanded at runtime.
+        size_t slot_count = storage_size / (slot_size + sizeof(CanardInternalRxSession*));
+        if (slot_count > RX_SESSIONS_PER_SUBSCRIPTION)
+        {
+            slot_count = RX_SESSIONS_PER_SUBSCRIPTION;
+        }
+        if ((slot_count > 0U) &&
+            (((slot_count * slot_size) + RX_SESSION_POOL_ALIGN_UP(slot_count * sizeof(CanardInternalRxSession*))) >
+             storage_size))
         {
-            for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+            slot_count--;  // The alignment padding of the array did not fit.
+        }
+        const size_t array_size = RX_SESSION_POOL_ALIGN_UP(slot_count * sizeof(CanardInternalRxSession*));
+#else
+        size_t slot_count = storage_size / slot_size;
+        if (slot_count > RX_SESSIONS_PER_SUBSCRIPTION)
+        {
+            slot_count = RX_SESSIONS_PER_SUBSCRIPTION;
+        }
+        const size_t array_size = 0U;
+#endif
+        if (slot_count > 0U)
+        {
+            // Intentional violation of MISRA: indexing on a pointer. The array size is only known at runtime.
+            out = rxSubscribe(ins,
+                              transfer_kind,
+                              port_id,
+                              extent,
+                              transfer_id_timeout_usec,
+                              &((uint8_t*) storage)[array_size],
+                              (uint8_t) slot_count,
+                              out_subscription);
+#if CANARD_CONFIG_SPARSE_RX_SESSIONS
+            if (out >= 0)
             {
-                // The sessions will be created ad-hoc. Normally, for a low-jitter deterministic system,
-                // we could have pre-allocated sessions here, but that requires too much memory to be feasible.
-                // We could accept an extra argument that would instruct us to pre-allocate sessions here?
-                out_subscription->_sessions[i] = NULL;
+                out_subscription->_sessions         = (CanardInternalRxSession**) storage;
+                out_subscription->_session_capacity = (uint8_t) slot_count;
             }
-            out_subscription->_transfer_id_timeout_usec = transfer_id_timeout_usec;
-            out_subscription->_extent                   = extent;
-            out_subscription->_port_id                  = port_id;
-            out_subscription->_next                     = ins->_rx_subscriptions[tk];
-            ins->_rx_subscriptions[tk]                  = out_subscription;
-            out                                         = (out > 0) ? 0 : 1;
+#endif
         }
     }
     return out;
@@ -1132,12 +2822,18 @@ int8_t canardRxUnsubscribe(CanardInstance* const    ins,
             {
                 ins->_rx_subscriptions[tk] = sub->_next;
             }
+            if ((ins->_rx_index[tk] != NULL) && (port_id <= rxGetPortIDMax(transfer_kind)))
+            {
+                CANARD_ASSERT(ins->_rx_index[tk][port_id] == sub);
+                ins->_rx_index[tk][port_id] = NULL;
+            }
 
-            for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
+            rxSessionsDestroy(ins, sub);
+            while (sub->_payload_free_list != NULL)
             {
-                ins->memory_free(ins, (sub->_sessions[i] != NULL) ? sub->_sessions[i]->payload : NULL);
-                ins->memory_free(ins, sub->_sessions[i]);
-                sub->_sessions[i] = NULL;
+                void* const payload     = sub->_payload_free_list;
+                sub->_payload_free_list = *(void**) payload;
+                ins->memory_free(ins, payload);
             }
         }
         else
@@ -1147,3 +2843,165 @@ int8_t canardRxUnsubscribe(CanardInstance* const    ins,
     }
     return out;
 }
+
+int8_t canardRxSetZeroCopy(CanardInstance* const    ins,
+                           const CanardTransferKind transfer_kind,
+                           const CanardPortID       port_id,
+                           const bool               enabled)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (((size_t) transfer_kind) < CANARD_NUM_TRANSFER_KINDS))
+    {
+        CanardRxSubscription* const sub = rxFindSubscription(ins, transfer_kind, port_id);
+        if (sub != NULL)
+        {
+            sub->_zero_copy = enabled;
+            out             = 1;
+        }
+        else
+        {
+            out = 0;
+        }
+    }
+    return out;
+}
+
+void canardRxReleasePayload(CanardInstance* const ins, const CanardTransfer* const transfer)
+{
+    // The payloads of pooled sessions and of frames delivered by reference are not the application's to release.
+    if ((ins != NULL) && (transfer != NULL) && (((size_t) transfer->transfer_kind) < CANARD_NUM_TRANSFER_KINDS) &&
+        (transfer->payload != NULL) && (transfer->payload_buffer_size > 0U))
+    {
+        CanardRxSubscription* const sub = rxFindSubscription(ins, transfer->transfer_kind, transfer->port_id);
+        if ((sub != NULL) && (NULL == sub->_session_pool) &&
+            (transfer->payload_buffer_size == RX_PAYLOAD_BUFFER_SIZE(sub->_extent)))
+        {
+            rxPayloadRecycle(sub, (void*) transfer->payload);
+        }
+        else
+        {
+            // The subscription is gone or was re-created with another extent or a pool; the buffer does not fit.
+            ins->memory_free(ins, (void*) transfer->payload);
+        }
+    }
+}
+
+CanardRxPayloadPoolStats canardRxGetPayloadPoolStats(const CanardRxSubscription* const subscription)
+{
+    CANARD_ASSERT(subscription != NULL);
+    const CanardRxPayloadPoolStats out = {
+        .hits   = subscription->_payload_pool_hits,
+        .misses = subscription->_payload_pool_misses,
+    };
+    return out;
+}
+
+int8_t canardRxSetIndex(CanardInstance* const        ins,
+                        const CanardTransferKind     transfer_kind,
+                        CanardRxSubscription** const index,
+                        const size_t                 index_size)
+{
+    int8_t       out = -CANARD_ERROR_INVALID_ARGUMENT;
+    const size_t tk  = (size_t) transfer_kind;
+    if ((ins != NULL) && (tk < CANARD_NUM_TRANSFER_KINDS) &&
+        ((NULL == index) || (index_size > (size_t) rxGetPortIDMax(transfer_kind))))
+    {
+        if (index != NULL)
+        {
+            const size_t size = ((size_t) rxGetPortIDMax(transfer_kind)) + 1U;
+            for (size_t i = 0; i < size; i++)
+            {
+                index[i] = NULL;
+            }
+            // Subscriptions with invalid port-ID values are not indexed; they cannot match any frame anyway.
+            for (CanardRxSubscription* sub = ins->_rx_subscriptions[tk]; sub != NULL; sub = sub->_next)
+            {
+                if (sub->_port_id < size)
+                {
+                    index[sub->_port_id] = sub;
+                }
+            }
+        }
+        ins->_rx_index[tk] = index;
+        out                = (index != NULL) ? 1 : 0;
+    }
+    return out;
+}
+
+CanardFilter canardMakeFilterForSubject(const CanardPortID subject_id)
+{
+    // The bits 21 and 22 are set by the publishers but ignored by the subscribers, and so is the anonymous flag.
+    CanardFilter out = {0};
+    out.extended_can_id = ((uint32_t) subject_id & CANARD_SUBJECT_ID_MAX) << OFFSET_SUBJECT_ID;
+    out.extended_mask   = FLAG_SERVICE_NOT_MESSAGE | FLAG_RESERVED_23 | FLAG_RESERVED_07 |
+                        (((uint32_t) CANARD_SUBJECT_ID_MAX) << OFFSET_SUBJECT_ID);
+    return out;
+}
+
+CanardFilter canardMakeFilterForService(const CanardPortID service_id, const CanardNodeID local_node_id)
+{
+    // Requests and responses are both accepted because the request-not-response flag is not checked.
+    CanardFilter out = {0};
+    out.extended_can_id = FLAG_SERVICE_NOT_MESSAGE |
+                          (((uint32_t) service_id & CANARD_SERVICE_ID_MAX) << OFFSET_SERVICE_ID) |
+                          (((uint32_t) local_node_id & CANARD_NODE_ID_MAX) << OFFSET_DST_NODE_ID);
+    out.extended_mask = FLAG_SERVICE_NOT_MESSAGE | FLAG_RESERVED_23 |
+                        (((uint32_t) CANARD_SERVICE_ID_MAX) << OFFSET_SERVICE_ID) |
+                        (((uint32_t) CANARD_NODE_ID_MAX) << OFFSET_DST_NODE_ID);
+    return out;
+}
+
+CanardFilter canardMakeFilterForServices(const CanardNodeID local_node_id)
+{
+    CanardFilter out = {0};
+    out.extended_can_id =
+        FLAG_SERVICE_NOT_MESSAGE | (((uint32_t) local_node_id & CANARD_NODE_ID_MAX) << OFFSET_DST_NODE_ID);
+    out.extended_mask =
+        FLAG_SERVICE_NOT_MESSAGE | FLAG_RESERVED_23 | (((uint32_t) CANARD_NODE_ID_MAX) << OFFSET_DST_NODE_ID);
+    return out;
+}
+
+CanardFilter canardConsolidateFilters(const CanardFilter* const a, const CanardFilter* const b)
+{
+    CANARD_ASSERT((a != NULL) && (b != NULL));
+    CanardFilter out = {0};
+    out.extended_mask   = a->extended_mask & b->extended_mask & ~(a->extended_can_id ^ b->extended_can_id);
+    out.extended_can_id = a->extended_can_id & out.extended_mask;
+    return out;
+}
+
+int32_t canardRxMakeFilters(const CanardInstance* const ins, CanardFilter* const out_filters, const size_t capacity)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (out_filters != NULL) && (capacity > 0U))
+    {
+        size_t size = 0U;
+        for (CanardRxSubscription* sub = ins->_rx_subscriptions[CanardTransferKindMessage]; sub != NULL;
+             sub = sub->_next)
+        {
+            if (sub->_port_id <= CANARD_SUBJECT_ID_MAX)
+            {
+                const CanardFilter flt = canardMakeFilterForSubject(sub->_port_id);
+                size                   = rxFilterAdd(out_filters, size, capacity, &flt);
+            }
+        }
+        // An anonymous node cannot take part in service exchanges, so the service subscriptions are not served.
+        if (ins->node_id <= CANARD_NODE_ID_MAX)
+        {
+            for (size_t tk = (size_t) CanardTransferKindResponse; tk < CANARD_NUM_TRANSFER_KINDS; tk++)
+            {
+                for (CanardRxSubscription* sub = ins->_rx_subscriptions[tk]; sub != NULL; sub = sub->_next)
+                {
+                    if (sub->_port_id <= CANARD_SERVICE_ID_MAX)
+                    {
+                        const CanardFilter flt = canardMakeFilterForService(sub->_port_id, ins->node_id);
+                        size                   = rxFilterAdd(out_filters, size, capacity, &flt);
+                    }
+                }
+            }
+        }
+        CANARD_ASSERT(size <= capacity);
+        out = (int32_t) size;
+    }
+    return out;
+}
@@ -124,6 +124,15 @@ extern "C" {
 #define CANARD_ERROR_INVALID_ARGUMENT 2
 #define CANARD_ERROR_OUT_OF_MEMORY 3
 
+/// Build configuration: if nonzero, the RX sessions of a subscription are kept in a compact sparse container instead
+/// of a table of CANARD_NODE_ID_MAX+1 pointers, which reduces the size of CanardRxSubscription by more than an order of
+/// magnitude (see its documentation). Unlike the other configuration options, which are located in canard.c, this one
+/// affects the layout of a public structure, so it shall be defined identically for the library and the application,
+/// e.g., via the compiler command line.
+#ifndef CANARD_CONFIG_SPARSE_RX_SESSIONS
+#    define CANARD_CONFIG_SPARSE_RX_SESSIONS 0
+#endif
+
 /// MTU values for the supported protocols.
 /// Per the recommendations given in the UAVCAN/CAN Specification, other MTU values should not be used.
 #define CANARD_MTU_CAN_CLASSIC 8U
@@ -256,6 +265,12 @@ typedef struct
     /// A more detailed overview of the dataflow and related resource management issues is provided in the API docs.
     size_t      payload_size;
     const void* payload;
+
+    /// For RX transfers: the size of the buffer that the library allocated for the payload and lent to the application
+    /// (see canardRxGetPayloadBufferSize()), or zero if the payload belongs to the library or to the frame it came in
+    /// (pooled subscriptions and zero-copy delivery). canardRxReleasePayload() relies on it.
+    /// For TX transfers: ignored.
+    size_t payload_buffer_size;
 } CanardTransfer;
 
 /// Transfer subscription state. The application can register its interest in a particular kind of data exchanged
@@ -286,13 +301,53 @@ typedef struct CanardRxSubscription
     /// just pointers, but it would push the size of this instance from about 0.5 KiB to ~3 KiB for a typical 32-bit
     /// system. Since this is a general-purpose library, we have to pick a middle ground so we use the more complex
     /// but more memory-efficient approach.
+    ///
+    /// If CANARD_CONFIG_SPARSE_RX_SESSIONS is enabled, the table is replaced with a 128-bit map of the node-IDs that
+    /// have a session plus a pointer to a dense array of session pointers sorted by node-ID. The array is allocated
+    /// dynamically on demand and grows geometrically, taking one pointer per live session (rounded up to a power of
+    /// two). This brings the size of this instance to a few dozen bytes while retaining the constant-time look-up,
+    /// at the cost of an extra allocation when the number of remote nodes exceeds the current capacity of the array.
+    /// This is preferable when there are many subscriptions and each of them has few publishers.
+#if CANARD_CONFIG_SPARSE_RX_SESSIONS
+    uint32_t                         _session_mask[(CANARD_NODE_ID_MAX + 1U) / 32U];
+    struct CanardInternalRxSession** _sessions;
+    uint8_t                          _session_capacity;
+#else
     struct CanardInternalRxSession* _sessions[CANARD_NODE_ID_MAX + 1U];
+#endif
 
     CanardMicrosecond _transfer_id_timeout_usec;  ///< Internal use only.
     size_t            _extent;                    ///< Internal use only.
+    uint8_t*          _session_pool;              ///< Internal use only. NULL unless canardRxSubscribeWithPool().
+    uint8_t           _session_pool_free;         ///< Internal use only.
+    bool              _zero_copy;                 ///< Internal use only. See canardRxSetZeroCopy().
+    void*             _payload_free_list;         ///< Internal use only. See canardRxReleasePayload().
     CanardPortID      _port_id;                   ///< Internal use only.
+    uint64_t          _payload_pool_hits;         ///< Internal use only. See canardRxGetPayloadPoolStats().
+    uint64_t          _payload_pool_misses;       ///< Internal use only. See canardRxGetPayloadPoolStats().
 } CanardRxSubscription;
 
+/// The statistics of the payload buffer free list of a subscription; see canardRxGetPayloadPoolStats().
+typedef struct
+{
+    /// The number of times a transfer payload buffer was taken from the free list populated by
+    /// canardRxReleasePayload().
+    uint64_t hits;
+
+    /// The number of times a buffer had to be allocated from the heap instead because the free list was empty,
+    /// including the unsuccessful allocations.
+    uint64_t misses;
+} CanardRxPayloadPoolStats;
+
+/// The policy applied by the preallocated TX queue storage when a new frame cannot be accommodated;
+/// see canardTxInitSlab(). Transfers are always dropped as a whole, never one frame at a time.
+typedef enum
+{
+    CanardTxOverflowReject             = 0,  ///< The new transfer is rejected with an out-of-memory error.
+    CanardTxOverflowDropLowestPriority = 1,  ///< Enqueued transfers of lower priority than the new one are dropped.
+    CanardTxOverflowDropOldest         = 2,  ///< The enqueued transfers that were pushed earliest are dropped.
+} CanardTxOverflowPolicy;
+
 /// A pointer to the memory allocation function. The semantics are similar to malloc():
 ///     - The returned pointer shall point to an uninitialized block of memory that is at least "amount" bytes large.
 ///     - If there is not enough memory, the returned pointer shall be NULL.
@@ -349,6 +404,10 @@ struct CanardInstance
     /// These fields are for internal use only. Do not access from the application.
     CanardRxSubscription*             _rx_subscriptions[CANARD_NUM_TRANSFER_KINDS];
     struct CanardInternalTxQueueItem* _tx_queue;
+    struct CanardInternalTreeNode*    _tx_queue_root;
+    struct CanardInternalTxSlab*      _tx_slab;
+    struct CanardInternalTreeNode*    _tx_deadline_root;
+    CanardRxSubscription**            _rx_index[CANARD_NUM_TRANSFER_KINDS];
 };
 
 /// Construct a new library instance.
@@ -379,7 +438,7 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 /// frames (so all frames will have the same timestamp value). This feature is intended to facilitate transmission
 /// deadline tracking, i.e., aborting frames that could not be transmitted before the specified deadline.
 /// Therefore, normally, the timestamp value should be in the future.
-/// The library itself, however, does not use or check this value in any way, so it can be zero if not needed.
+/// The library only uses this value in canardTxExpire(), so it can be zero if that function is not used.
 ///
 /// The function returns the number of frames enqueued into the prioritized TX queue (which is always a positive
 /// number) in case of success (so that the application can track the number of items in the TX queue if necessary).
@@ -402,14 +461,36 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 /// In that case, all previously allocated frames will be deallocated automatically. In other words, either all frames
 /// of the transfer are enqueued successfully, or none are.
 ///
-/// The time complexity is O(p+e), where p is the amount of payload in the transfer, and e is the number of frames
-/// already enqueued in the transmission queue.
+/// The time complexity is O(p+f*log(e)), where p is the amount of payload in the transfer, f is the number of frames
+/// it is split into, and e is the number of frames already enqueued in the transmission queue. The queue is indexed
+/// by CAN ID with a balanced binary tree, so the cost of locating the insertion point grows slowly with the queue.
 ///
 /// The memory allocation requirement is one allocation per transport frame. A single-frame transfer takes one
 /// allocation; a multi-frame transfer of N frames takes N allocations. The maximum size of each allocation is
-/// (sizeof(CanardFrame) + sizeof(void*) + MTU).
+/// (sizeof(CanardFrame) + 9*sizeof(void*) + MTU), or (sizeof(CanardFrame) + 5*sizeof(void*) + MTU) if the library
+/// is built with CANARD_CONFIG_TX_DEADLINE_INDEX=0 (see canardTxExpire()); canardTxGetItemSize() gives the exact value.
 int32_t canardTxPush(CanardInstance* const ins, const CanardTransfer* const transfer);
 
+/// This function is equivalent to invoking canardTxPush() for each of the transfers in the array, in order.
+/// It is intended for applications that emit many transfers at once (e.g., once per control cycle); the per-call
+/// overheads, such as the evaluation of the MTU setting, are paid once per batch rather than once per transfer.
+///
+/// Unlike canardTxPush(), a failure to enqueue one transfer does not affect the others: each transfer is either
+/// enqueued completely or not at all, independently. If out_results is not NULL, it shall point to an array of
+/// count elements; the i-th element receives the result that canardTxPush() would have returned for the i-th
+/// transfer (the number of frames enqueued or a negated error code).
+///
+/// The return value is the total number of frames enqueued, which may be zero if every transfer was rejected.
+/// The total saturates at INT32_MAX; use out_results to account for the frames exactly in such extreme cases.
+/// A negated invalid argument error is returned if the instance is NULL, or if the transfer array is NULL while
+/// the count is nonzero; in this case, out_results is not modified.
+///
+/// The time and memory complexity is the sum of those of canardTxPush() over the transfers in the batch.
+int32_t canardTxPushBatch(CanardInstance* const       ins,
+                          const CanardTransfer* const transfers,
+                          const size_t                count,
+                          int32_t* const              out_results);
+
 /// This function accesses the top element of the prioritized transmission queue. The queue itself is not modified
 /// (i.e., the accessed element is not removed). The application should invoke this function to collect the transport
 /// frames of serialized transfers pushed into the prioritized transmission queue by canardTxPush().
@@ -419,17 +500,17 @@ int32_t canardTxPush(CanardInstance* const ins, const CanardTransfer* const tran
 ///
 /// The timestamp values of returned frames are initialized with the timestamp value of the transfer instance they
 /// originate from. Timestamps are used to specify the transmission deadline. It is up to the application and/or
-/// the media layer to implement the discardment of timed-out transport frames. The library does not check it,
-/// so a frame that is already timed out may be returned here.
+/// the media layer to implement the discardment of timed-out transport frames, e.g., by invoking canardTxExpire()
+/// periodically. This function does not check it, so a frame that is already timed out may be returned here.
 ///
 /// If the queue is empty or if the argument is NULL, the returned value is NULL.
 ///
 /// If the queue is non-empty, the returned value is a pointer to its top element (i.e., the next frame to transmit).
 /// The returned pointer points to an object allocated in the dynamic storage; it should be eventually freed by the
-/// application by calling CanardInstance::memory_free(). The memory shall not be freed before the entry is removed
-/// from the queue by calling canardTxPop(); this is because until canardTxPop() is executed, the library retains
-/// ownership of the object. The pointer retains validity until explicitly freed by the application; in other words,
-/// calling canardTxPop() does not invalidate the object.
+/// application by calling CanardInstance::memory_free(), or canardTxFree() if the slab storage is used. The memory
+/// shall not be freed before the entry is removed from the queue by calling canardTxPop(); this is because until
+/// canardTxPop() is executed, the library retains ownership of the object. The pointer retains validity until
+/// explicitly freed by the application; in other words, calling canardTxPop() does not invalidate the object.
 ///
 /// The payload buffer is located shortly after the object itself, in the same memory fragment. The application shall
 /// not attempt to free it.
@@ -449,9 +530,83 @@ const CanardFrame* canardTxPeek(const CanardInstance* const ins);
 ///
 /// If the input argument is NULL or if the transmission queue is empty, the function has no effect.
 ///
-/// The time complexity is constant. This function does not invoke the dynamic memory manager.
+/// The time complexity is logarithmic from the number of enqueued frames because the frame has to be removed from
+/// the queue index. This function does not invoke the dynamic memory manager.
 void canardTxPop(CanardInstance* const ins);
 
+/// This function removes the transfers whose transmission deadline has passed from the transmission queue and frees
+/// the memory of their frames (returning it to the slab if canardTxInitSlab() is used). A frame is expired if its
+/// timestamp is less than now_usec; the time system shall be the same as that of the transfer timestamps.
+/// Transfers are removed as a whole: since all frames of a transfer share the same deadline, they expire together.
+/// If some frames of a transfer were transmitted already, the remaining frames are removed.
+///
+/// The frame at the top of the queue may be removed, so the warning of canardTxPop() applies to this function as well:
+/// a pointer obtained from canardTxPeek() before this call shall not be used to pop or free the frame afterwards.
+///
+/// The return value is the number of frames removed, or a negated invalid argument error if the instance is NULL.
+/// If out_transfer_count is not NULL, the number of removed transfers is stored there (zero on error).
+///
+/// The queue is indexed by deadline in addition to the priority, so the time complexity is O(k*log(n)),
+/// where k is the number of removed frames and n is the number of enqueued frames. In particular, if nothing has
+/// expired, the cost is logarithmic regardless of the queue length. The index costs four pointers per enqueued frame;
+/// if the library is built with CANARD_CONFIG_TX_DEADLINE_INDEX=0, it is omitted and the queue is scanned instead,
+/// so the time complexity becomes O(n+k*log(n)). This function does not allocate memory.
+int32_t canardTxExpire(CanardInstance* const ins, const CanardMicrosecond now_usec, size_t* const out_transfer_count);
+
+/// This function switches the transmission queue of the instance from the dynamic memory manager to a fixed-capacity
+/// storage provided by the application. Afterwards, canardTxPush() takes the memory for the TX frames from the
+/// storage instead of invoking CanardInstance::memory_allocate(), so the TX pipeline performs no dynamic memory
+/// allocation at all. This is useful for systems where the TX traffic is bursty and the worst-case queue length
+/// is known: the storage is sized once and the allocation latency and fragmentation are eliminated.
+///
+/// The storage is divided into equally sized slots, each of which can hold one frame of any MTU up to
+/// CANARD_MTU_CAN_FD; a small part of the storage in the beginning is used for the control block. The storage
+/// pointer shall be aligned at least at max(sizeof(uint64_t), sizeof(void*)). The storage shall remain valid for
+/// the lifetime of the instance and it shall not be accessed by the application afterwards.
+///
+/// When a slot cannot be found for a new frame, the overflow policy is applied: either the new transfer is rejected
+/// with an out-of-memory error (as if the heap was exhausted), or previously enqueued transfers are dropped as a
+/// whole to make room, which may affect the frame at the top of the queue (see the warning of canardTxPop()).
+/// The drop-lowest-priority policy only drops transfers whose CAN ID is greater than that of the new transfer;
+/// if there are none, the new transfer is rejected. The drop-oldest policy drops transfers in the order they were
+/// pushed regardless of their priority. Either way, a push remains all-or-nothing: a transfer that needs more slots
+/// than the policy could make available (e.g., more than the capacity of the storage) is rejected before anything
+/// is dropped.
+///
+/// Once the storage is installed, the frames returned by canardTxPeek() and then removed by canardTxPop() shall be
+/// released using canardTxFree() instead of CanardInstance::memory_free(). The mode cannot be reverted, and the
+/// storage cannot be replaced. Frames popped before the storage was installed may still be released using
+/// canardTxFree(); they are told apart by their address and returned to the heap.
+///
+/// The frames that the application has popped but not yet released occupy their slots; the overflow policy cannot
+/// drop them, so they do not count towards the room it can make.
+///
+/// The return value is the number of slots (i.e., the TX queue capacity in frames) on success.
+/// The return value is a negated invalid argument error if the instance or the storage pointer is NULL,
+/// if the storage is misaligned or is too small to hold at least one slot, if the policy is invalid,
+/// if the transmission queue is not empty, or if a storage is installed already.
+///
+/// The time complexity is linear from the number of slots. This function does not invoke the dynamic memory manager.
+/// In the slab mode, canardTxPush() has the same time complexity as in the heap mode, plus the cost of dropping the
+/// evicted frames, which is linear from their number and logarithmic from the length of the queue.
+int32_t canardTxInitSlab(CanardInstance* const        ins,
+                         void* const                  storage,
+                         const size_t                 storage_size,
+                         const CanardTxOverflowPolicy overflow_policy);
+
+/// This function releases a TX frame that was removed from the queue by canardTxPop(). It works in both memory
+/// modes: if the slab storage is not installed (see canardTxInitSlab()), the frame is returned to the heap via
+/// CanardInstance::memory_free(); otherwise, its slot is returned to the slab. If either argument is NULL,
+/// the function has no effect. The time complexity is constant.
+void canardTxFree(CanardInstance* const ins, const CanardFrame* const frame);
+
+/// Returns the size of the memory block that canardTxPush() requests from CanardInstance::memory_allocate() for a TX
+/// frame carrying the specified number of payload bytes (including the padding and the tail byte). The largest
+/// block for an instance is obtained with the MTU as the argument; smaller ones are requested for the last frames
+/// of multi-frame transfers and for short single-frame transfers. The result depends on the platform only, so it can
+/// be used to size fixed-block memory pools statically (see the memory allocation requirement model).
+size_t canardTxGetItemSize(const size_t payload_size);
+
 /// This function implements the transfer reassembly logic. It accepts a transport frame, locates the appropriate
 /// subscription state, and, if found, updates it. If the frame completed a transfer, the return value is 1 (one)
 /// and the out_transfer pointer is populated with the parameters of the newly reassembled transfer. The transfer
@@ -464,7 +619,8 @@ void canardTxPop(CanardInstance* const ins);
 /// The index of the transport from which the transfer is accepted is always the same as redundant_transport_index
 /// of the current invocation, so the application can always determine which transport has delivered the transfer.
 ///
-/// The function invokes the dynamic memory manager in the following cases only:
+/// The function invokes the dynamic memory manager in the following cases only (never for subscriptions created
+/// using canardRxSubscribeWithPool()):
 ///
 ///     1. New memory for a session state object is allocated when a new session is initiated.
 ///        This event occurs when a transport frame that matches a known subscription is received from a node that
@@ -477,7 +633,7 @@ void canardTxPop(CanardInstance* const ins);
 ///        The size of a session instance is at most 48 bytes on any conventional platform (typically much smaller).
 ///
 ///     2. New memory for the transfer payload buffer is allocated when a new transfer is initiated, unless the buffer
-///        was already allocated at the time.
+///        was already allocated at the time or there is a buffer released earlier by canardRxReleasePayload().
 ///        This event occurs when a transport frame that matches a known subscription is received and it begins a
 ///        new transfer (that is, the start-of-frame flag is set and it is not a duplicate).
 ///        The amount of the allocated memory equals the extent as configured via canardRxSubscribe(); please read
@@ -504,7 +660,9 @@ void canardTxPop(CanardInstance* const ins);
 ///
 /// The time complexity is O(n+p) where n is the number of subject-IDs or service-IDs subscribed to by the application,
 /// depending on the transfer kind of the supplied frame, and p is the amount of payload in the received frame
-/// (because it will be copied into an internal contiguous buffer). Observe that the time complexity is invariant to
+/// (because it will be copied into an internal contiguous buffer). If the subscription index is installed for the
+/// transfer kind of the frame using canardRxSetIndex(), the subscription search takes constant time, so the time
+/// complexity reduces to O(p). Observe that the time complexity is invariant to
 /// the network configuration (such as the number of online nodes) -- this is a very important design guarantee for
 /// real-time applications because the execution time is dependent only on the number of active subscriptions for
 /// a given transfer kind, and the MTU, both of which are easy to predict and account for. Excepting the
@@ -517,7 +675,12 @@ void canardTxPop(CanardInstance* const ins);
 /// it is a single-frame transfer, its payload is copied out into a new dynamically allocated buffer storage).
 /// If the extent is zero, the payload pointer may be NULL, since there is no data to store and so a
 /// buffer is not needed. The application is responsible for deallocating the payload buffer when the processing
-/// is done by invoking memory_free on the transfer payload pointer.
+/// is done by invoking memory_free on the transfer payload pointer or, preferably, by returning it to the library
+/// for reuse via canardRxReleasePayload(). Transfers received via pooled subscriptions are an exception: their
+/// payload buffers are only lent to the application, and the payload of an anonymous transfer received via a pooled
+/// subscription references the supplied frame; see canardRxSubscribeWithPool().
+/// Single-frame transfers received via subscriptions with the zero-copy delivery enabled are another exception:
+/// their payload is referenced in the supplied frame rather than copied out; see canardRxSetZeroCopy().
 ///
 /// The function returns a negated out-of-memory error if it was unable to allocate dynamic memory.
 ///
@@ -549,6 +712,36 @@ int8_t canardRxAccept(CanardInstance* const    ins,
                       const uint8_t            redundant_transport_index,
                       CanardTransfer* const    out_transfer);
 
+/// This function is equivalent to invoking canardRxAccept() for each of the frames in the array, in order, with the
+/// same redundant transport index, and collecting the transfers it produces into out_transfers in the order of
+/// completion. It is a convenience for applications that drain many frames from the media layer at once; it is not
+/// faster than the per-frame loop. The ownership of the payloads of the returned transfers is the same as described
+/// in canardRxAccept().
+///
+/// The processing stops early in two cases, and the application shall consume the transfers before invoking this
+/// function again with the rest of the frames. First, once out_capacity transfers have been stored, because the next
+/// frame may complete another one. Second, after the frame that completes a transfer received via a pooled
+/// subscription (see canardRxSubscribeWithPool()), because its payload is lent from the session, which the next frame
+/// from the same remote node would overwrite. The number of frames processed is stored into out_frame_count; it
+/// equals count unless the processing stopped early. The pointer may be NULL only if out_capacity is not less than
+/// count and there are no pooled subscriptions with remote (non-anonymous) publishers.
+///
+/// The return value is the number of transfers stored into out_transfers, which may be zero.
+/// Frames that canardRxAccept() would reject, whether as invalid arguments or due to the lack of memory, are skipped
+/// without affecting the other frames in the batch; a transfer that cannot be reassembled due to the lack of memory
+/// is lost, as it would be with canardRxAccept().
+/// A negated invalid argument error is returned if the instance is NULL, or if either array is NULL while the count is
+/// nonzero; in this case, no frames are processed.
+///
+/// The time and memory complexity is the sum of those of canardRxAccept() over the processed frames.
+int32_t canardRxAcceptBatch(CanardInstance* const    ins,
+                            const CanardFrame* const frames,
+                            const size_t             count,
+                            const uint8_t            redundant_transport_index,
+                            CanardTransfer* const    out_transfers,
+                            const size_t             out_capacity,
+                            size_t* const            out_frame_count);
+
 /// This function creates a new subscription, allowing the application to register its interest in a particular
 /// category of transfers. The library will reject all transport frames for which there is no active subscription.
 /// The reference out_subscription shall retain validity until the subscription is terminated (the referred object
@@ -591,9 +784,55 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
                          const CanardMicrosecond     transfer_id_timeout_usec,
                          CanardRxSubscription* const out_subscription);
 
-/// This function reverses the effect of canardRxSubscribe().
+/// This is a variant of canardRxSubscribe() for applications that require the RX pipeline to never invoke the dynamic
+/// memory manager. The session states and their payload buffers are taken from the provided storage instead of the
+/// heap, so canardRxAccept() never allocates memory for transfers matching this subscription and it never reports
+/// an out-of-memory error for them.
+///
+/// The storage is split into equally sized slots, one per remote node, where each slot contains a session state and
+/// a payload buffer of the specified extent; the size of a slot is returned by canardRxGetSessionPoolSlotSize().
+/// The number of slots is (storage_size / slot_size) but not more than (CANARD_NODE_ID_MAX+1); if the library is built
+/// with CANARD_CONFIG_SPARSE_RX_SESSIONS, the storage also hosts one pointer per slot, plus alignment padding.
+/// A slot is bound to the remote node that first emits a matching transfer and it is retained until the subscription
+/// is terminated. Once all slots are taken, frames from further remote nodes are silently ignored (no error).
+/// The storage shall be aligned at least as strictly as a pointer and a CanardMicrosecond, and it shall remain valid
+/// until the subscription is terminated; the library does not free it.
+///
+/// The payload buffer of a transfer received via a pooled subscription is not handed over to the application but lent
+/// to it: the application shall not free it, and it remains valid until the next invocation of canardRxAccept() or
+/// canardRxUnsubscribe() with the same instance. The application shall copy the payload out if it needs it later.
+/// Anonymous transfers have no session to borrow a buffer from, so their payload references the supplied frame,
+/// as described in canardRxSetZeroCopy().
+///
+/// The return values and the time complexity are the same as those of canardRxSubscribe(); additionally,
+/// the negated invalid argument error is returned if the storage is NULL, misaligned, or too small for one slot.
+int8_t canardRxSubscribeWithPool(CanardInstance* const       ins,
+                                 const CanardTransferKind    transfer_kind,
+                                 const CanardPortID          port_id,
+                                 const size_t                extent,
+                                 const CanardMicrosecond     transfer_id_timeout_usec,
+                                 void* const                 storage,
+                                 const size_t                storage_size,
+                                 CanardRxSubscription* const out_subscription);
+
+/// Returns the size of the storage required per remote node by canardRxSubscribeWithPool() for the given extent.
+/// The result depends on the platform only and it can be used to size the storage statically.
+size_t canardRxGetSessionPoolSlotSize(const size_t extent);
+
+/// Returns the size of the memory block that canardRxAccept() requests from CanardInstance::memory_allocate() for the
+/// state of a new RX session (one per remote node per subscription). The result depends on the platform only.
+size_t canardRxGetSessionSize(void);
+
+/// Returns the size of the memory block that canardRxAccept() requests from CanardInstance::memory_allocate() for the
+/// payload buffer of a transfer received via a subscription with the specified extent. The result depends on the
+/// extent and the platform only. If the library is built with CANARD_CONFIG_SPARSE_RX_SESSIONS, the session pointer
+/// arrays are allocated as well; their size varies with the number of remote nodes.
+size_t canardRxGetPayloadBufferSize(const size_t extent);
+
+/// This function reverses the effect of canardRxSubscribe() and canardRxSubscribeWithPool().
 /// If the subscription is found, all its memory is de-allocated (session states and payload buffers); to determine
 /// the amount of memory freed, please refer to the memory allocation requirement model of canardRxAccept().
+/// The storage of a pooled subscription is not freed; the application may reuse it once this function returns.
 ///
 /// The return value is 1 if such subscription existed (and, therefore, it was removed).
 /// The return value is 0 if such subscription does not exist. In this case, the function has no effect.
@@ -605,6 +844,131 @@ int8_t canardRxUnsubscribe(CanardInstance* const    ins,
                            const CanardTransferKind transfer_kind,
                            const CanardPortID       port_id);
 
+/// This function returns the payload buffer of a received transfer to the library instead of freeing it with
+/// memory_free. The buffer is put into the free list of the subscription that the transfer was received through,
+/// and it will be reused for a subsequent transfer of that subscription without invoking the memory manager.
+/// In the steady state, when the application releases every payload it receives, the number of buffers in circulation
+/// stops growing and canardRxAccept() allocates no payload memory at all; see canardRxGetPayloadPoolStats().
+/// The same free list also receives the buffers of transfers that the library drops due to errors or timeouts.
+///
+/// The buffer is freed with memory_free instead if the subscription no longer exists, or if its buffer size
+/// (payload_buffer_size of the transfer) does not match the current extent of the subscription, which happens if the
+/// subscription was re-created with another extent since the transfer was received. The buffers in the free list are
+/// freed when the subscription is terminated by canardRxUnsubscribe(). Payloads that do not belong to the application
+/// are ignored: those of pooled subscriptions (see canardRxSubscribeWithPool()) and those delivered by reference to
+/// the frame buffer (see canardRxSetZeroCopy()), which have a zero payload_buffer_size. A NULL payload is ignored.
+/// The transfer shall be the one returned by canardRxAccept() or canardRxAcceptBatch().
+///
+/// The time complexity is that of the subscription search in canardRxAccept().
+void canardRxReleasePayload(CanardInstance* const ins, const CanardTransfer* const transfer);
+
+/// Returns the statistics of the payload buffer free list of the subscription (see canardRxReleasePayload()), which
+/// tell whether the buffers are recycled as intended. The counters are reset when the subscription is (re-)created.
+/// Pooled subscriptions and zero-copy deliveries do not use the free list, so they do not affect the counters.
+/// The subscription pointer shall be valid. The time complexity is constant.
+CanardRxPayloadPoolStats canardRxGetPayloadPoolStats(const CanardRxSubscription* const subscription);
+
+/// This function enables or disables the zero-copy delivery of single-frame transfers for the specified subscription.
+/// It is disabled by default, and canardRxSubscribe() disables it when the subscription is re-created.
+///
+/// When enabled, canardRxAccept() does not copy the payload of a single-frame transfer (nor an anonymous one) into
+/// a new buffer; instead, the payload pointer of the resulting transfer object points directly into the payload of
+/// the frame supplied by the application (the implicit truncation rule still applies to the payload size), so there
+/// is neither a memory allocation nor a copy. Such payload is lent to the application: it remains valid only as long
+/// as the frame buffer is kept intact (normally, until it is reused for the next canardRxAccept() call), and it shall
+/// not be freed. Multi-frame transfers are still reassembled into a contiguous buffer and delivered as usual, so the
+/// application distinguishes the two cases by comparing the transfer payload pointer with the frame payload pointer:
+/// the transfer payload shall be freed by the application only if the pointers differ (and the subscription is not
+/// pooled; see canardRxSubscribeWithPool()).
+///
+/// The return value is 1 if the subscription exists (and, therefore, the setting has been applied).
+/// The return value is 0 if such subscription does not exist. In this case, the function has no effect.
+/// The return value is a negated invalid argument error if any of the input arguments are invalid.
+///
+/// The time complexity is that of the subscription search in canardRxAccept().
+/// This function does not invoke the dynamic memory manager.
+int8_t canardRxSetZeroCopy(CanardInstance* const    ins,
+                           const CanardTransferKind transfer_kind,
+                           const CanardPortID       port_id,
+                           const bool               enabled);
+
+/// This function installs a direct look-up table that maps port-ID values to subscriptions of the specified transfer
+/// kind, which makes the subscription search in canardRxAccept() take constant time instead of linear from the number
+/// of subscriptions. This is a time-memory trade-off intended for nodes with many subscriptions: the table has one
+/// pointer per valid port-ID, i.e., (CANARD_SUBJECT_ID_MAX+1) entries for messages and (CANARD_SERVICE_ID_MAX+1)
+/// entries for either kind of services, which is 32 KiB and 2 KiB respectively on a 32-bit platform.
+///
+/// The table is provided by the application and it shall remain valid until it is uninstalled or the instance is
+/// discarded; the application shall not access it afterwards. The table is populated from the existing subscriptions,
+/// so the function can be invoked at any time; canardRxSubscribe() and canardRxUnsubscribe() keep it in sync.
+/// If the table pointer is NULL, the index is uninstalled and the linear search is used again.
+/// Each transfer kind has its own index, so, for example, only the messages may be indexed.
+///
+/// The return value is 1 if the index has been installed and 0 if it has been uninstalled.
+/// The return value is a negated invalid argument error if the instance is NULL, if the transfer kind is invalid,
+/// or if the table is not NULL and its size (the number of entries) is not sufficient for the transfer kind.
+///
+/// The time complexity is linear from the size of the table plus the number of subscriptions under the transfer kind.
+/// This function does not invoke the dynamic memory manager.
+int8_t canardRxSetIndex(CanardInstance* const        ins,
+                        const CanardTransferKind     transfer_kind,
+                        CanardRxSubscription** const index,
+                        const size_t                 index_size);
+
+/// A CAN acceptance filter configuration with an extended 29-bit ID and a mask of the same width.
+/// A frame is accepted if (frame_can_id & extended_mask) == (extended_can_id & extended_mask).
+/// The filters can be loaded into the CAN controller or the OS network stack (e.g., SocketCAN CAN_RAW_FILTER) to let
+/// the hardware or the kernel drop the frames that the local node is not interested in, so that they do not have to be
+/// delivered to the application only to be discarded by canardRxAccept().
+typedef struct
+{
+    uint32_t extended_can_id;
+    uint32_t extended_mask;
+} CanardFilter;
+
+/// Returns a filter that accepts all message transfers under the specified subject-ID, anonymous ones included.
+/// The subject-ID is truncated to CANARD_SUBJECT_ID_MAX.
+/// This function does not invoke the dynamic memory manager.
+CanardFilter canardMakeFilterForSubject(const CanardPortID subject_id);
+
+/// Returns a filter that accepts the service requests and responses under the specified service-ID that are addressed
+/// to the local node. The service-ID is truncated to CANARD_SERVICE_ID_MAX, the node-ID to CANARD_NODE_ID_MAX.
+/// This function does not invoke the dynamic memory manager.
+CanardFilter canardMakeFilterForService(const CanardPortID service_id, const CanardNodeID local_node_id);
+
+/// Returns a filter that accepts all service transfers addressed to the local node regardless of the service-ID.
+/// The node-ID is truncated to CANARD_NODE_ID_MAX.
+/// This function does not invoke the dynamic memory manager.
+CanardFilter canardMakeFilterForServices(const CanardNodeID local_node_id);
+
+/// Returns a filter that accepts every frame accepted by either of the two filters, and generally some other frames
+/// as well: the bits where the two filters disagree are removed from the mask. Use this to fit a set of filters into
+/// a limited number of hardware filter banks. Both pointers shall be valid.
+/// This function does not invoke the dynamic memory manager.
+CanardFilter canardConsolidateFilters(const CanardFilter* const a, const CanardFilter* const b);
+
+/// Builds the acceptance filters that admit the transfers the local node is subscribed to: every message subscription,
+/// and every service subscription as long as the local node is not anonymous (an anonymous node cannot receive service
+/// transfers). Every frame that canardRxAccept() may accept under the current subscriptions and node-ID passes the
+/// filters; if the capacity is not sufficient to keep the filters exact, some other frames pass as well.
+///
+/// At most 'capacity' filters are written into the output array. Subscriptions that are covered by an existing filter
+/// do not take a new one. If the number of distinct subscriptions exceeds the capacity, the filters are merged using
+/// canardConsolidateFilters() pairwise such that the merged filters keep as many of the CAN ID bits as possible;
+/// this minimizes the number of unwanted frames that pass in a greedy manner (the result is not guaranteed optimal).
+///
+/// The filters reflect the state at the moment of the call, so they should be rebuilt and reapplied whenever a
+/// subscription is added or removed or the node-ID is changed.
+///
+/// The return value is the number of filters written, which is zero if there are no subscriptions to serve
+/// (in which case the node does not need to receive any frames at all).
+/// The return value is a negated invalid argument error if the instance or the output array is NULL or if the
+/// capacity is zero.
+///
+/// The time complexity is O(n*c^2), where n is the number of subscriptions and c is the capacity.
+/// This function does not invoke the dynamic memory manager.
+int32_t canardRxMakeFilters(const CanardInstance* const ins, CanardFilter* const out_filters, const size_t capacity);
+
 #ifdef __cplusplus
 }
 #endif
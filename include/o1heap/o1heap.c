@@ -38,6 +38,14 @@
 #    endif
 #endif
 
+/// If nonzero, the instance keeps the per-bin counts of the free fragments and the per-size-class counts of the
+/// allocated ones that o1heapGetExtendedDiagnostics() reports. They take two words per bin, i.e., 1 KiB on a 64-bit
+/// target, at the beginning of the arena, which is a large share of a small one; so they are disabled by default
+/// and reported as zeros.
+#ifndef O1HEAP_FRAGMENT_HISTOGRAMS
+#    define O1HEAP_FRAGMENT_HISTOGRAMS 0
+#endif
+
 /// This option is used for testing only. Do not use in production.
 #if defined(O1HEAP_EXPOSE_INTERNALS) && O1HEAP_EXPOSE_INTERNALS
 #    define O1HEAP_PRIVATE
@@ -71,6 +79,7 @@
 /// Normally we should subtract log2(FRAGMENT_SIZE_MIN) but log2 is bulky to compute using the preprocessor only.
 /// We will certainly end up with unused bins this way, but it is cheap to ignore.
 #define NUM_BINS_MAX (sizeof(size_t) * 8U)
+static_assert(NUM_BINS_MAX == O1HEAP_BIN_COUNT, "Diagnostics layout error");
 
 static_assert((O1HEAP_ALIGNMENT & (O1HEAP_ALIGNMENT - 1U)) == 0U, "Not a power of 2");
 static_assert((FRAGMENT_SIZE_MIN & (FRAGMENT_SIZE_MIN - 1U)) == 0U, "Not a power of 2");
@@ -105,6 +114,16 @@ struct O1HeapInstance
     O1HeapHook critical_section_leave;
 
     O1HeapDiagnostics diagnostics;
+
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+    size_t free_fragments[NUM_BINS_MAX];       ///< Per bin; kept in sync with the bins by rebin() and unbin().
+    size_t allocated_fragments[NUM_BINS_MAX];  ///< Per size class, indexed by log2(fragment size / FRAGMENT_SIZE_MIN).
+#endif
+
+    O1HeapSamplingHook sampling_hook;
+    void*              sampling_user_reference;
+    size_t             sampling_period;
+    size_t             sampling_countdown;
 };
 
 /// The amount of space allocated for the heap instance.
@@ -196,6 +215,9 @@ O1HEAP_PRIVATE void rebin(O1HeapInstance* const handle, Fragment* const fragment
     }
     handle->bins[idx] = fragment;
     handle->nonempty_bin_mask |= pow2(idx);
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+    handle->free_fragments[idx]++;
+#endif
 }
 
 /// Removes the specified block from its bin.
@@ -208,6 +230,10 @@ O1HEAP_PRIVATE void unbin(O1HeapInstance* const handle, const Fragment* const fr
     O1HEAP_ASSERT((fragment->header.size % FRAGMENT_SIZE_MIN) == 0U);
     const uint8_t idx = log2Floor(fragment->header.size / FRAGMENT_SIZE_MIN);  // Round DOWN when removing.
     O1HEAP_ASSERT(idx < NUM_BINS_MAX);
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+    O1HEAP_ASSERT(handle->free_fragments[idx] > 0U);
+    handle->free_fragments[idx]--;
+#endif
     // Remove the bin from the free fragment list.
     if (O1HEAP_LIKELY(fragment->next_free != NULL))
     {
@@ -229,66 +255,10 @@ O1HEAP_PRIVATE void unbin(O1HeapInstance* const handle, const Fragment* const fr
     }
 }
 
-// ---------------------------------------- PUBLIC API IMPLEMENTATION ----------------------------------------
-
-O1HeapInstance* o1heapInit(void* const      base,
-                           const size_t     size,
-                           const O1HeapHook critical_section_enter,
-                           const O1HeapHook critical_section_leave)
-{
-    O1HeapInstance* out = NULL;
-    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) &&
-        (size >= (INSTANCE_SIZE_PADDED + FRAGMENT_SIZE_MIN)))
-    {
-        // Allocate the core heap metadata structure in the beginning of the arena.
-        O1HEAP_ASSERT(((size_t) base) % sizeof(O1HeapInstance*) == 0U);
-        out                         = (O1HeapInstance*) base;
-        out->nonempty_bin_mask      = 0U;
-        out->critical_section_enter = critical_section_enter;
-        out->critical_section_leave = critical_section_leave;
-        for (size_t i = 0; i < NUM_BINS_MAX; i++)
-        {
-            out->bins[i] = NULL;
-        }
-
-        // Limit and align the capacity.
-        size_t capacity = size - INSTANCE_SIZE_PADDED;
-        if (capacity > FRAGMENT_SIZE_MAX)
-        {
-            capacity = FRAGMENT_SIZE_MAX;
-        }
-        while ((capacity % FRAGMENT_SIZE_MIN) != 0)
-        {
-            O1HEAP_ASSERT(capacity > 0U);
-            capacity--;
-        }
-        O1HEAP_ASSERT((capacity % FRAGMENT_SIZE_MIN) == 0);
-        O1HEAP_ASSERT((capacity >= FRAGMENT_SIZE_MIN) && (capacity <= FRAGMENT_SIZE_MAX));
-
-        // Initialize the root fragment.
-        Fragment* const frag = (Fragment*) (void*) (((uint8_t*) base) + INSTANCE_SIZE_PADDED);
-        O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
-        frag->header.next = NULL;
-        frag->header.prev = NULL;
-        frag->header.size = capacity;
-        frag->header.used = false;
-        frag->next_free   = NULL;
-        frag->prev_free   = NULL;
-        rebin(out, frag);
-        O1HEAP_ASSERT(out->nonempty_bin_mask != 0U);
-
-        // Initialize the diagnostics.
-        out->diagnostics.capacity          = capacity;
-        out->diagnostics.allocated         = 0U;
-        out->diagnostics.peak_allocated    = 0U;
-        out->diagnostics.peak_request_size = 0U;
-        out->diagnostics.oom_count         = 0U;
-    }
-
-    return out;
-}
-
-void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
+/// Allocates a fragment; the caller shall be in the critical section. See o1heapAllocate().
+/// A failure is not counted in the diagnostics here, because a short batch is not an out-of-memory condition.
+O1HEAP_PRIVATE void* doAllocate(O1HeapInstance* const handle, const size_t amount);
+O1HEAP_PRIVATE void* doAllocate(O1HeapInstance* const handle, const size_t amount)
 {
     O1HEAP_ASSERT(handle != NULL);
     O1HEAP_ASSERT(handle->diagnostics.capacity <= FRAGMENT_SIZE_MAX);
@@ -311,8 +281,6 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
         O1HEAP_ASSERT(optimal_bin_index < NUM_BINS_MAX);
         const size_t candidate_bin_mask = ~(pow2(optimal_bin_index) - 1U);
 
-        invoke(handle->critical_section_enter);
-
         // Find the smallest non-empty bin we can use.
         const size_t suitable_bins     = handle->nonempty_bin_mask & candidate_bin_mask;
         const size_t smallest_bin_mask = suitable_bins & ~(suitable_bins - 1U);  // Clear all bits but the lowest.
@@ -355,6 +323,9 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
             {
                 handle->diagnostics.peak_allocated = handle->diagnostics.allocated;
             }
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+            handle->allocated_fragments[optimal_bin_index]++;
+#endif
 
             // Finalize the fragment we just allocated.
             O1HEAP_ASSERT(frag->header.size >= amount + O1HEAP_ALIGNMENT);
@@ -363,26 +334,19 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
             out = ((uint8_t*) frag) + O1HEAP_ALIGNMENT;
         }
     }
-    else
-    {
-        invoke(handle->critical_section_enter);
-    }
 
     // Update the diagnostics.
     if (O1HEAP_LIKELY(handle->diagnostics.peak_request_size < amount))
     {
         handle->diagnostics.peak_request_size = amount;
     }
-    if (O1HEAP_LIKELY((out == NULL) && (amount > 0U)))
-    {
-        handle->diagnostics.oom_count++;
-    }
 
-    invoke(handle->critical_section_leave);
     return out;
 }
 
-void o1heapFree(O1HeapInstance* const handle, void* const pointer)
+/// Frees a fragment; the caller shall be in the critical section. See o1heapFree().
+O1HEAP_PRIVATE void doFree(O1HeapInstance* const handle, void* const pointer);
+O1HEAP_PRIVATE void doFree(O1HeapInstance* const handle, void* const pointer)
 {
     O1HEAP_ASSERT(handle != NULL);
     O1HEAP_ASSERT(handle->diagnostics.capacity <= FRAGMENT_SIZE_MAX);
@@ -402,14 +366,17 @@ void o1heapFree(O1HeapInstance* const handle, void* const pointer)
         O1HEAP_ASSERT(frag->header.size <= handle->diagnostics.capacity);
         O1HEAP_ASSERT((frag->header.size % FRAGMENT_SIZE_MIN) == 0U);
 
-        invoke(handle->critical_section_enter);
-
         // Even if we're going to drop the fragment later, mark it free anyway to prevent double-free.
         frag->header.used = false;
 
         // Update the diagnostics. It must be done before merging because it invalidates the fragment size information.
         O1HEAP_ASSERT(handle->diagnostics.allocated >= frag->header.size);  // Heap corruption check.
         handle->diagnostics.allocated -= frag->header.size;
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+        const uint8_t size_class = log2Floor(frag->header.size / FRAGMENT_SIZE_MIN);
+        O1HEAP_ASSERT(handle->allocated_fragments[size_class] > 0U);
+        handle->allocated_fragments[size_class]--;
+#endif
 
         // Merge with siblings and insert the returned fragment into the appropriate bin and update metadata.
         Fragment* const prev       = frag->header.prev;
@@ -449,11 +416,191 @@ void o1heapFree(O1HeapInstance* const handle, void* const pointer)
         {
             rebin(handle, frag);
         }
+    }
+}
+
+/// Counts an allocation attempt towards the sampling period and the failures, and returns the hook to invoke once the
+/// critical section is left, or NULL if no sample is due; the caller shall be in the critical section.
+/// See o1heapSetSamplingHook().
+O1HEAP_PRIVATE O1HeapSamplingHook takeSample(O1HeapInstance* const handle, const bool failed);
+O1HEAP_PRIVATE O1HeapSamplingHook takeSample(O1HeapInstance* const handle, const bool failed)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (failed)
+    {
+        handle->diagnostics.oom_count++;
+    }
+    bool due = failed;
+    if (handle->sampling_period > 0U)
+    {
+        O1HEAP_ASSERT(handle->sampling_countdown > 0U);
+        handle->sampling_countdown--;
+        if (handle->sampling_countdown == 0U)
+        {
+            handle->sampling_countdown = handle->sampling_period;
+            due                        = true;
+        }
+    }
+    return due ? handle->sampling_hook : NULL;
+}
 
+// ---------------------------------------- PUBLIC API IMPLEMENTATION ----------------------------------------
+
+O1HeapInstance* o1heapInit(void* const      base,
+                           const size_t     size,
+                           const O1HeapHook critical_section_enter,
+                           const O1HeapHook critical_section_leave)
+{
+    O1HeapInstance* out = NULL;
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) &&
+        (size >= (INSTANCE_SIZE_PADDED + FRAGMENT_SIZE_MIN)))
+    {
+        // Allocate the core heap metadata structure in the beginning of the arena.
+        O1HEAP_ASSERT(((size_t) base) % sizeof(O1HeapInstance*) == 0U);
+        out                         = (O1HeapInstance*) base;
+        out->nonempty_bin_mask      = 0U;
+        out->critical_section_enter = critical_section_enter;
+        out->critical_section_leave = critical_section_leave;
+        for (size_t i = 0; i < NUM_BINS_MAX; i++)
+        {
+            out->bins[i] = NULL;
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+            out->free_fragments[i]      = 0U;
+            out->allocated_fragments[i] = 0U;
+#endif
+        }
+        out->sampling_hook           = NULL;
+        out->sampling_user_reference = NULL;
+        out->sampling_period         = 0U;
+        out->sampling_countdown      = 0U;
+
+        // Limit and align the capacity.
+        size_t capacity = size - INSTANCE_SIZE_PADDED;
+        if (capacity > FRAGMENT_SIZE_MAX)
+        {
+            capacity = FRAGMENT_SIZE_MAX;
+        }
+        while ((capacity % FRAGMENT_SIZE_MIN) != 0)
+        {
+            O1HEAP_ASSERT(capacity > 0U);
+            capacity--;
+        }
+        O1HEAP_ASSERT((capacity % FRAGMENT_SIZE_MIN) == 0);
+        O1HEAP_ASSERT((capacity >= FRAGMENT_SIZE_MIN) && (capacity <= FRAGMENT_SIZE_MAX));
+
+        // Initialize the root fragment.
+        Fragment* const frag = (Fragment*) (void*) (((uint8_t*) base) + INSTANCE_SIZE_PADDED);
+        O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
+        frag->header.next = NULL;
+        frag->header.prev = NULL;
+        frag->header.size = capacity;
+        frag->header.used = false;
+        frag->next_free   = NULL;
+        frag->prev_free   = NULL;
+        rebin(out, frag);
+        O1HEAP_ASSERT(out->nonempty_bin_mask != 0U);
+
+        // Initialize the diagnostics.
+        out->diagnostics.capacity          = capacity;
+        out->diagnostics.allocated         = 0U;
+        out->diagnostics.peak_allocated    = 0U;
+        out->diagnostics.peak_request_size = 0U;
+        out->diagnostics.oom_count         = 0U;
+    }
+
+    return out;
+}
+
+void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    invoke(handle->critical_section_enter);
+    void* const              out            = doAllocate(handle, amount);
+    const O1HeapSamplingHook hook           = takeSample(handle, (out == NULL) && (amount > 0U));
+    void* const              user_reference = handle->sampling_user_reference;
+    invoke(handle->critical_section_leave);
+    if (hook != NULL)
+    {
+        hook(handle, user_reference);
+    }
+    return out;
+}
+
+void o1heapFree(O1HeapInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_LIKELY(pointer != NULL))  // NULL pointer is a no-op; the hooks are not invoked.
+    {
+        invoke(handle->critical_section_enter);
+        doFree(handle, pointer);
         invoke(handle->critical_section_leave);
     }
 }
 
+size_t o1heapAllocateBatch(O1HeapInstance* const handle,
+                           const size_t          amount,
+                           void** const          out_pointers,
+                           const size_t          count)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT((out_pointers != NULL) || (count == 0U));
+    size_t             out  = 0U;
+    O1HeapSamplingHook hook = NULL;
+    invoke(handle->critical_section_enter);
+    while (out < count)
+    {
+        void* const ptr = doAllocate(handle, amount);
+        // A batch that ends short is not an out-of-memory condition; only one that obtains nothing is.
+        if ((ptr != NULL) || (out == 0U))
+        {
+            const O1HeapSamplingHook due = takeSample(handle, (ptr == NULL) && (amount > 0U));
+            hook                         = (due != NULL) ? due : hook;  // At most one sample per batch.
+        }
+        if (ptr == NULL)
+        {
+            break;
+        }
+        out_pointers[out] = ptr;
+        out++;
+    }
+    void* const user_reference = handle->sampling_user_reference;
+    invoke(handle->critical_section_leave);
+    if (hook != NULL)
+    {
+        hook(handle, user_reference);
+    }
+    return out;
+}
+
+void o1heapFreeBatch(O1HeapInstance* const handle, void* const* const pointers, const size_t count)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT((pointers != NULL) || (count == 0U));
+    invoke(handle->critical_section_enter);
+    for (size_t i = 0U; i < count; i++)
+    {
+        doFree(handle, pointers[i]);
+    }
+    invoke(handle->critical_section_leave);
+}
+
+size_t o1heapGetAllocationSize(const O1HeapInstance* const handle, const void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    (void) handle;
+    size_t out = 0U;
+    if (O1HEAP_LIKELY(pointer != NULL))
+    {
+        // The size of an allocated fragment cannot change until it is freed, so no locking is needed.
+        const Fragment* const frag = (const Fragment*) (const void*) (((const uint8_t*) pointer) - O1HEAP_ALIGNMENT);
+        O1HEAP_ASSERT(frag->header.used);
+        O1HEAP_ASSERT(frag->header.size >= FRAGMENT_SIZE_MIN);
+        O1HEAP_ASSERT(isPowerOf2(frag->header.size));
+        out = frag->header.size - O1HEAP_ALIGNMENT;
+    }
+    return out;
+}
+
 bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
 {
     O1HEAP_ASSERT(handle != NULL);
@@ -467,6 +614,9 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
         const bool mask_bit_set = (handle->nonempty_bin_mask & pow2((uint8_t) i)) != 0U;
         const bool bin_nonempty = handle->bins[i] != NULL;
         valid                   = valid && (mask_bit_set == bin_nonempty);
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+        valid = valid && ((handle->free_fragments[i] > 0U) == bin_nonempty);
+#endif
     }
 
     // Create a local copy of the diagnostics struct to check later and release the critical section early.
@@ -506,3 +656,45 @@ O1HeapDiagnostics o1heapGetDiagnostics(const O1HeapInstance* const handle)
     invoke(handle->critical_section_leave);
     return out;
 }
+
+void o1heapGetExtendedDiagnostics(const O1HeapInstance* const handle, O1HeapExtendedDiagnostics* const out)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(out != NULL);
+    invoke(handle->critical_section_enter);
+    out->basic = handle->diagnostics;
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+#if O1HEAP_FRAGMENT_HISTOGRAMS
+        out->free_fragments[i]      = handle->free_fragments[i];
+        out->allocated_fragments[i] = handle->allocated_fragments[i];
+#else
+        out->free_fragments[i]      = 0U;
+        out->allocated_fragments[i] = 0U;
+#endif
+    }
+    const size_t nonempty_bin_mask = handle->nonempty_bin_mask;
+    invoke(handle->critical_section_leave);
+
+    // Every fragment in the highest non-empty bin is at least as large as the lower bound of the bin, and doAllocate()
+    // serves a fragment size from that bin if it does not exceed the bound; larger ones need a higher bin.
+    out->largest_allocation = 0U;
+    if (nonempty_bin_mask != 0U)
+    {
+        out->largest_allocation = (FRAGMENT_SIZE_MIN << log2Floor(nonempty_bin_mask)) - O1HEAP_ALIGNMENT;
+    }
+}
+
+void o1heapSetSamplingHook(O1HeapInstance* const    handle,
+                           const size_t             period,
+                           const O1HeapSamplingHook hook,
+                           void* const              user_reference)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    invoke(handle->critical_section_enter);
+    handle->sampling_hook           = hook;
+    handle->sampling_user_reference = user_reference;
+    handle->sampling_period         = (hook != NULL) ? period : 0U;
+    handle->sampling_countdown      = handle->sampling_period;
+    invoke(handle->critical_section_leave);
+}
@@ -69,6 +69,39 @@ typedef struct
     uint64_t oom_count;
 } O1HeapDiagnostics;
 
+/// The number of free fragment bins and allocated fragment size classes reported by @ref O1HeapExtendedDiagnostics.
+/// Only the first few are used in a real heap: the index of the last one is log2(capacity / (2*O1HEAP_ALIGNMENT)).
+#define O1HEAP_BIN_COUNT (sizeof(size_t) * 8U)
+
+/// Diagnostic information that allows telling fragmentation apart from genuine exhaustion.
+/// If an allocation fails while (capacity - allocated) is well above largest_allocation, the heap is fragmented:
+/// there is enough free memory but it is scattered across small fragments, as the free_fragments histogram shows.
+/// The histograms take 1 KiB of the arena on a 64-bit target, so they are kept only if o1heap.c is built with
+/// O1HEAP_FRAGMENT_HISTOGRAMS defined nonzero; otherwise they are reported as zeros.
+/// See @ref o1heapGetExtendedDiagnostics().
+typedef struct
+{
+    /// Same as returned by @ref o1heapGetDiagnostics(), sampled atomically with the rest.
+    O1HeapDiagnostics basic;
+
+    /// The number of free fragments per bin. The bin at index i holds the fragments whose size is at least
+    /// (2*O1HEAP_ALIGNMENT << i) and less than twice that.
+    size_t free_fragments[O1HEAP_BIN_COUNT];
+
+    /// The number of allocated fragments per size class. The fragments of the class at index i are
+    /// (2*O1HEAP_ALIGNMENT << i) bytes large and serve the requests of up to that minus O1HEAP_ALIGNMENT bytes.
+    /// The fragments kept in the per-thread magazines of o1heap_cache.h are counted here (and in basic.allocated)
+    /// even though no application object occupies them; o1heapCacheFlush() returns those of the calling thread.
+    size_t allocated_fragments[O1HEAP_BIN_COUNT];
+
+    /// The largest amount for which an allocation is currently guaranteed to succeed, or zero if none is.
+    /// Larger requests fail even if a larger free fragment exists, because the fragment size is rounded up.
+    size_t largest_allocation;
+} O1HeapExtendedDiagnostics;
+
+/// A hook invoked outside of the critical section to sample the state of the heap, see @ref o1heapSetSamplingHook().
+typedef void (*O1HeapSamplingHook)(O1HeapInstance* const handle, void* const user_reference);
+
 /// The arena base pointer shall be aligned at @ref O1HEAP_ALIGNMENT, otherwise NULL is returned.
 ///
 /// The total heap capacity cannot exceed approx. (SIZE_MAX/2). If the arena size allows for a larger heap,
@@ -84,7 +117,7 @@ typedef struct
 /// The callbacks are never invoked from the initialization function itself.
 ///
 /// The function initializes a new heap instance allocated in the provided arena, taking some of its space for its
-/// own needs (normally about 40..600 bytes depending on the architecture, but this parameter is not characterized).
+/// own needs (normally about 450..1700 bytes depending on the architecture, but this parameter is not characterized).
 /// A pointer to the newly initialized instance is returned.
 ///
 /// If the provided space is insufficient, NULL is returned.
@@ -123,6 +156,31 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount);
 /// The function may invoke critical_section_enter and critical_section_leave at most once each (NULL hooks ignored).
 void o1heapFree(O1HeapInstance* const handle, void* const pointer);
 
+/// Allocates up to 'count' fragments of the same size within a single critical section and stores the pointers
+/// into the output array. This is meant for allocation caches that take fragments from a shared heap in batches,
+/// so that the critical section is entered once per batch rather than once per fragment.
+/// Each allocation follows the semantics of o1heapAllocate(), including the diagnostics.
+/// The allocation stops at the first failure; the return value is the number of fragments allocated.
+/// The failure counts as an out-of-memory condition (oom_count and the sampling hook) only if nothing was allocated.
+/// The time complexity is linear from the count.
+/// The function invokes critical_section_enter and critical_section_leave once each (NULL hooks ignored).
+size_t o1heapAllocateBatch(O1HeapInstance* const handle,
+                           const size_t          amount,
+                           void** const          out_pointers,
+                           const size_t          count);
+
+/// Frees the specified fragments within a single critical section. Each pointer follows the semantics of o1heapFree();
+/// NULL pointers are ignored. The time complexity is linear from the count.
+/// The function invokes critical_section_enter and critical_section_leave once each (NULL hooks ignored).
+void o1heapFreeBatch(O1HeapInstance* const handle, void* const* const pointers, const size_t count);
+
+/// Returns the number of bytes that can be used in the allocated memory fragment, which is the requested amount
+/// rounded up to the fragment size (a power of two) minus the per-fragment overhead. The value depends only on the
+/// requested amount: an allocation of o1heapGetAllocationSize() bytes occupies a fragment of the same size.
+/// The pointer shall point to a previously allocated block that is not yet freed; if it is NULL, zero is returned.
+/// The critical section hooks are not invoked. The time complexity is constant.
+size_t o1heapGetAllocationSize(const O1HeapInstance* const handle, const void* const pointer);
+
 /// Performs a basic sanity check on the heap.
 /// This function can be used as a weak but fast method of heap corruption detection.
 /// It invokes critical_section_enter once (unless NULL) and then critical_section_leave once (unless NULL).
@@ -137,6 +195,24 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle);
 /// If the handle pointer is NULL, the behavior is undefined.
 O1HeapDiagnostics o1heapGetDiagnostics(const O1HeapInstance* const handle);
 
+/// Samples the extended diagnostic information into the output structure, see @ref O1HeapExtendedDiagnostics.
+/// The histograms are maintained incrementally by the allocator, so the critical section only covers copying them
+/// (about 2*O1HEAP_BIN_COUNT words); the free lists are not traversed.
+/// It invokes critical_section_enter once (unless NULL) and then critical_section_leave once (unless NULL).
+/// If either pointer is NULL, the behavior is undefined. The time complexity is constant.
+void o1heapGetExtendedDiagnostics(const O1HeapInstance* const handle, O1HeapExtendedDiagnostics* const out);
+
+/// Installs a hook that is invoked after every period-th allocation attempt and after every failed allocation
+/// (if the period is zero, only after failed ones). The hook is invoked by the allocating thread after it has left
+/// the critical section, so it can take a snapshot with @ref o1heapGetExtendedDiagnostics() and log it without
+/// delaying other threads for longer than the copying takes. A NULL hook disables sampling.
+/// The hook shall not allocate from the same heap. The user reference is passed to the hook as-is.
+/// It invokes critical_section_enter once (unless NULL) and then critical_section_leave once (unless NULL).
+void o1heapSetSamplingHook(O1HeapInstance* const    handle,
+                           const size_t             period,
+                           const O1HeapSamplingHook hook,
+                           void* const              user_reference);
+
 #ifdef __cplusplus
 }
 #endif
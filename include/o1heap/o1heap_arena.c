@@ -0,0 +1,308 @@
+// A growable set of o1heap arenas. See o1heap_arena.h.
+
+#define _GNU_SOURCE  // MAP_HUGETLB, MADV_HUGEPAGE and syscall() are Linux extensions.
+
+#include "o1heap_arena.h"
+#include <assert.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+/// An upper bound of the space o1heap takes from the arena for its own instance, which is 450..1700 bytes.
+/// A page is reserved, which also keeps the arena sizes page-aligned.
+#define ARENA_OVERHEAD_MAX 4096U
+
+static uint64_t monotonicUsec(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000ULL) + ((uint64_t) ts.tv_nsec / 1000ULL);
+}
+
+static size_t getPageSize(void)
+{
+    const long page_size = sysconf(_SC_PAGESIZE);
+    return (page_size > 0) ? (size_t) page_size : 4096U;
+}
+
+static size_t roundUp(const size_t x, const size_t step)
+{
+    return ((x + step - 1U) / step) * step;
+}
+
+static size_t roundUpToPage(const size_t x)
+{
+    return roundUp(x, getPageSize());
+}
+
+static void* mapAnonymous(const size_t size, const int extra_flags)
+{
+    void* const out = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return (out != MAP_FAILED) ? out : NULL;
+}
+
+/// Maps a region for transparent huge pages: the kernel can only use them for 2 MiB-aligned ranges, which mmap()
+/// does not guarantee, so a larger range is mapped and trimmed to the alignment.
+static void* mapTransparentHugePages(const size_t size)
+{
+    uint8_t* const raw = (uint8_t*) mapAnonymous(size + O1HEAP_ARENA_HUGEPAGE_SIZE, 0);
+    uint8_t*       out = NULL;
+    if (raw != NULL)
+    {
+        out               = (uint8_t*) roundUp((size_t) raw, O1HEAP_ARENA_HUGEPAGE_SIZE);
+        const size_t head = (size_t) (out - raw);
+        const size_t tail = O1HEAP_ARENA_HUGEPAGE_SIZE - head;
+        if (head > 0U)
+        {
+            (void) munmap(raw, head);
+        }
+        if (tail > 0U)
+        {
+            (void) munmap(out + size, tail);
+        }
+        (void) madvise(out, size, MADV_HUGEPAGE);  // Not fatal: THP may be disabled, then regular pages are used.
+    }
+    return out;
+}
+
+/// Sets the preferred NUMA node of the region to the node of the calling thread's CPU. Returns the node or -1.
+/// libnuma is not required: getcpu() and mbind() are invoked directly.
+static int preferLocalNumaNode(void* const base, const size_t size)
+{
+    unsigned cpu  = 0U;
+    unsigned node = 0U;
+    int      out  = -1;
+    if ((syscall(SYS_getcpu, &cpu, &node, NULL) == 0) && (node < 64U))
+    {
+        const unsigned long nodemask = 1UL << node;
+        // The kernel disregards the last bit of maxnode, hence the extra one.
+        if (syscall(SYS_mbind, base, size, MPOL_PREFERRED, &nodemask, (unsigned long) (sizeof(nodemask) * 8U) + 1U,
+                    0U) == 0)
+        {
+            out = (int) node;
+        }
+    }
+    return out;
+}
+
+bool o1heapArenaMap(const size_t size, const uint32_t flags, O1HeapArenaRegion* const out_region)
+{
+    O1HEAP_ASSERT(out_region != NULL);
+    out_region->base      = NULL;
+    out_region->size      = 0U;
+    out_region->hugetlb   = false;
+    out_region->numa_node = -1;
+    if ((size > 0U) && (size <= (SIZE_MAX / 2U)))
+    {
+        if ((flags & O1HEAP_ARENA_FLAG_HUGEPAGES) != 0U)
+        {
+            out_region->size = roundUp(size, O1HEAP_ARENA_HUGEPAGE_SIZE);
+            // Fails immediately unless enough huge pages are reserved, in which case THP is the next best option.
+            out_region->base    = mapAnonymous(out_region->size, MAP_HUGETLB);
+            out_region->hugetlb = (out_region->base != NULL);
+            if (out_region->base == NULL)
+            {
+                out_region->base = mapTransparentHugePages(out_region->size);
+            }
+        }
+        else
+        {
+            out_region->size = roundUpToPage(size);
+            out_region->base = mapAnonymous(out_region->size, 0);
+        }
+    }
+    if ((out_region->base != NULL) && ((flags & O1HEAP_ARENA_FLAG_NUMA_LOCAL) != 0U))
+    {
+        out_region->numa_node = preferLocalNumaNode(out_region->base, out_region->size);
+    }
+    if ((out_region->base != NULL) && ((flags & O1HEAP_ARENA_FLAG_PREFAULT) != 0U))
+    {
+        // Writing is required: a read would map the shared zero page and the fault would be taken later anyway.
+        const size_t step = out_region->hugetlb ? O1HEAP_ARENA_HUGEPAGE_SIZE : getPageSize();
+        for (size_t offset = 0U; offset < out_region->size; offset += step)
+        {
+            ((volatile uint8_t*) out_region->base)[offset] = 0U;
+        }
+    }
+    return out_region->base != NULL;
+}
+
+void o1heapArenaUnmap(const O1HeapArenaRegion* const region)
+{
+    if ((region != NULL) && (region->base != NULL))
+    {
+        (void) munmap(region->base, region->size);
+    }
+}
+
+/// Maps and initializes a new arena at the end of the set. Returns false if the set is full or the OS refuses.
+static bool mapArena(O1HeapArenaSet* const set, const size_t size)
+{
+    bool ok = set->arena_count < O1HEAP_ARENA_COUNT_MAX;
+    if (ok)
+    {
+        O1HeapArena* const arena = &set->arenas[set->arena_count];
+        ok                       = o1heapArenaMap(size, set->flags, &arena->region);
+        if (ok)
+        {
+            arena->heap             = o1heapInit(arena->region.base, arena->region.size, NULL, NULL);
+            arena->allocation_count = 0U;
+            arena->empty_since_usec  = monotonicUsec();
+            O1HEAP_ASSERT(arena->heap != NULL);
+            set->arena_count++;
+        }
+    }
+    return ok;
+}
+
+/// Returns the index of the arena that contains the pointer, or arena_count if none does.
+static size_t findArena(const O1HeapArenaSet* const set, const void* const pointer)
+{
+    size_t i = 0U;
+    while (i < set->arena_count)
+    {
+        const uint8_t* const base = (const uint8_t*) set->arenas[i].region.base;
+        if (((const uint8_t*) pointer >= base) && ((const uint8_t*) pointer < (base + set->arenas[i].region.size)))
+        {
+            break;
+        }
+        i++;
+    }
+    return i;
+}
+
+bool o1heapArenaSetInit(O1HeapArenaSet* const set,
+                        const size_t          initial_size,
+                        const size_t          growth_size,
+                        const uint64_t        cooldown_usec,
+                        const uint32_t        flags)
+{
+    bool ok = (set != NULL) && (initial_size > 0U) && (growth_size > 0U);
+    if (ok)
+    {
+        (void) memset(set, 0, sizeof(O1HeapArenaSet));
+        set->growth_size   = roundUpToPage(growth_size);
+        set->cooldown_usec = cooldown_usec;
+        set->flags         = flags;
+        ok                 = mapArena(set, initial_size);
+    }
+    return ok;
+}
+
+void o1heapArenaSetDestroy(O1HeapArenaSet* const set)
+{
+    if (set != NULL)
+    {
+        for (size_t i = 0U; i < set->arena_count; i++)
+        {
+            o1heapArenaUnmap(&set->arenas[i].region);
+        }
+        set->arena_count = 0U;
+    }
+}
+
+void* o1heapArenaSetAllocate(O1HeapArenaSet* const set, const size_t amount)
+{
+    O1HEAP_ASSERT(set != NULL);
+    void*  out = NULL;
+    size_t i   = 0U;
+    if (amount > 0U)
+    {
+        while ((out == NULL) && (i < set->arena_count))
+        {
+            out = o1heapAllocate(set->arenas[i].heap, amount);
+            i += (out == NULL) ? 1U : 0U;
+        }
+        // The largest fragment o1heap can carve from a fresh arena of a given capacity is the power of two that
+        // fits the amount plus the fragment header, so that much is mapped in the worst case.
+        if ((out == NULL) && (amount <= (SIZE_MAX / 4U)))
+        {
+            size_t fragment_size = O1HEAP_ALIGNMENT * 2U;
+            while (fragment_size < (amount + O1HEAP_ALIGNMENT))
+            {
+                fragment_size <<= 1U;
+            }
+            const size_t size = fragment_size + ARENA_OVERHEAD_MAX;
+            if (mapArena(set, (size > set->growth_size) ? size : set->growth_size))
+            {
+                i   = set->arena_count - 1U;
+                out = o1heapAllocate(set->arenas[i].heap, amount);
+                O1HEAP_ASSERT(out != NULL);
+                set->grow_count++;
+            }
+        }
+    }
+    if (out != NULL)
+    {
+        set->arenas[i].allocation_count++;
+    }
+    else if (amount > 0U)
+    {
+        set->oom_count++;
+    }
+    else
+    {
+        (void) 0;
+    }
+    return out;
+}
+
+void o1heapArenaSetFree(O1HeapArenaSet* const set, void* const pointer)
+{
+    O1HEAP_ASSERT(set != NULL);
+    if (pointer != NULL)
+    {
+        const size_t i = findArena(set, pointer);
+        O1HEAP_ASSERT(i < set->arena_count);
+        if (i < set->arena_count)
+        {
+            O1HeapArena* const arena = &set->arenas[i];
+            O1HEAP_ASSERT(arena->allocation_count > 0U);
+            o1heapFree(arena->heap, pointer);
+            arena->allocation_count--;
+            if ((arena->allocation_count == 0U) && (i > 0U))  // The first arena is never released.
+            {
+                arena->empty_since_usec = monotonicUsec();
+            }
+        }
+        (void) o1heapArenaSetTrim(set);
+    }
+}
+
+size_t o1heapArenaSetTrim(O1HeapArenaSet* const set)
+{
+    O1HEAP_ASSERT(set != NULL);
+    size_t   out = 0U;
+    uint64_t now = 0U;  // Sampled lazily so that the common case does not read the clock.
+    size_t   i   = 1U;
+    while (i < set->arena_count)
+    {
+        O1HeapArena* const arena = &set->arenas[i];
+        if ((arena->allocation_count == 0U) && (now == 0U))
+        {
+            now = monotonicUsec();
+        }
+        if ((arena->allocation_count == 0U) && ((now - arena->empty_since_usec) >= set->cooldown_usec))
+        {
+            o1heapArenaUnmap(&arena->region);
+            // Keep the arenas ordered by age so that the allocation preference is preserved.
+            (void) memmove(arena, arena + 1, sizeof(O1HeapArena) * (set->arena_count - i - 1U));
+            set->arena_count--;
+            set->release_count++;
+            out++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,118 @@
+// A growable set of o1heap arenas.
+//
+// An o1heap instance manages one fixed arena, so an application whose peak memory demand is hard to bound either
+// reserves the worst case up front or runs out of memory under load. This layer starts with one arena and maps
+// another one from the OS (mmap) when none of the existing arenas can serve a request. Each allocation still costs
+// at most one o1heapAllocate() per arena, and the number of arenas is limited by O1HEAP_ARENA_COUNT_MAX, so the
+// bound stays constant; only the allocation that maps a new arena makes a system call.
+// A pointer is freed to the arena whose address range contains it.
+// An additional arena that has been empty for longer than the cooldown is unmapped; the first arena is kept forever.
+// The cooldown prevents a workload that oscillates around an arena boundary from mapping and unmapping on every cycle.
+//
+// The memory backing the arenas can be tuned with the O1HEAP_ARENA_FLAG_* options; o1heapArenaMap() provides the same
+// memory to applications that initialize o1heap themselves.
+//
+// This layer is specific to Linux. It is not thread-safe; a set shared between threads shall be protected by
+// the caller. The arenas are created without critical section hooks for the same reason.
+
+#ifndef O1HEAP_ARENA_H_INCLUDED
+#define O1HEAP_ARENA_H_INCLUDED
+
+#include "o1heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of arenas in a set, including the first one.
+#ifndef O1HEAP_ARENA_COUNT_MAX
+#    define O1HEAP_ARENA_COUNT_MAX 8U
+#endif
+
+/// Back the arenas with 2 MiB huge pages to avoid TLB misses. Explicit huge pages (MAP_HUGETLB) are used if the
+/// system has them reserved (vm.nr_hugepages), otherwise transparent huge pages are requested with MADV_HUGEPAGE.
+/// The arena size is rounded up to a multiple of the huge page size.
+#define O1HEAP_ARENA_FLAG_HUGEPAGES (1U << 0U)
+
+/// Prefer the NUMA node of the CPU the calling thread runs on at the time the arena is mapped. This should be the
+/// thread that owns the heap, and it should be pinned to its CPU, otherwise the node is merely a guess.
+/// The policy is a preference rather than a strict binding, so that a full node does not cause an allocation failure.
+#define O1HEAP_ARENA_FLAG_NUMA_LOCAL (1U << 1U)
+
+/// Touch every page of the arena right after mapping it, so that the page faults happen at startup rather than
+/// during the first allocations. Combined with the NUMA policy, the pages are faulted on the preferred node.
+#define O1HEAP_ARENA_FLAG_PREFAULT (1U << 2U)
+
+/// The huge page size assumed by O1HEAP_ARENA_FLAG_HUGEPAGES; the default on x86-64 and AArch64.
+#define O1HEAP_ARENA_HUGEPAGE_SIZE (2UL * 1024UL * 1024UL)
+
+/// Describes a region mapped by o1heapArenaMap().
+typedef struct
+{
+    void*  base;       ///< Aligned at the page size, which satisfies O1HEAP_ALIGNMENT.
+    size_t size;       ///< The requested size rounded up to the page size (or the huge page size).
+    bool   hugetlb;    ///< True if backed by explicit huge pages; transparent huge pages are not reported.
+    int    numa_node;  ///< The preferred NUMA node, or -1 if no policy was applied.
+} O1HeapArenaRegion;
+
+/// Maps an anonymous region of at least the specified size with the O1HEAP_ARENA_FLAG_* options, which is suitable
+/// for o1heapInit(). The options that are not supported by the system are skipped silently; the region reports
+/// which ones took effect. Returns false if the region cannot be mapped at all.
+bool o1heapArenaMap(const size_t size, const uint32_t flags, O1HeapArenaRegion* const out_region);
+
+/// Unmaps a region returned by o1heapArenaMap().
+void o1heapArenaUnmap(const O1HeapArenaRegion* const region);
+
+/// One arena of the set. The fields are read-only for the application.
+typedef struct
+{
+    O1HeapInstance*   heap;              ///< Located at the beginning of the region.
+    O1HeapArenaRegion region;            ///< The memory the arena occupies.
+    size_t            allocation_count;  ///< The number of fragments currently allocated from this arena.
+    uint64_t          empty_since_usec;  ///< When the arena became empty; meaningful only if allocation_count is zero.
+} O1HeapArena;
+
+typedef struct
+{
+    O1HeapArena arenas[O1HEAP_ARENA_COUNT_MAX];  ///< The first arena_count entries are valid; [0] is never released.
+    size_t      arena_count;
+    size_t      growth_size;    ///< The minimum size of an additional arena.
+    uint32_t    flags;          ///< The O1HEAP_ARENA_FLAG_* options the arenas are mapped with.
+    uint64_t    cooldown_usec;  ///< How long an additional arena shall stay empty before it is unmapped.
+
+    uint64_t grow_count;     ///< The number of arenas mapped after initialization. Never decreased.
+    uint64_t release_count;  ///< The number of arenas unmapped. Never decreased.
+    uint64_t oom_count;      ///< The number of requests that could not be served by any arena. Never decreased.
+} O1HeapArenaSet;
+
+/// Maps the first arena of the specified size and initializes the set. Additional arenas are at least growth_size
+/// bytes large; a larger one is mapped if a single request does not fit. The sizes are rounded up to the page size.
+/// All arenas are mapped with the specified O1HEAP_ARENA_FLAG_* options, see o1heapArenaMap().
+/// Returns false if the first arena cannot be mapped or the arguments are invalid.
+bool o1heapArenaSetInit(O1HeapArenaSet* const set,
+                        const size_t          initial_size,
+                        const size_t          growth_size,
+                        const uint64_t        cooldown_usec,
+                        const uint32_t        flags);
+
+/// Unmaps all arenas. All pointers allocated from the set become invalid.
+void o1heapArenaSetDestroy(O1HeapArenaSet* const set);
+
+/// Serves the request from the first arena that can; the older arenas are preferred so that the newer ones drain
+/// and can be released. If no arena can serve the request, a new one is mapped, unless the set is full.
+/// Returns NULL if the request cannot be served. The semantics otherwise follows o1heapAllocate().
+void* o1heapArenaSetAllocate(O1HeapArenaSet* const set, const size_t amount);
+
+/// Frees the fragment to the arena it was allocated from. NULL pointers are ignored.
+/// The additional arenas whose cooldown has expired are unmapped here.
+void o1heapArenaSetFree(O1HeapArenaSet* const set, void* const pointer);
+
+/// Unmaps the additional arenas that have been empty for longer than the cooldown. This is done by
+/// o1heapArenaSetFree() as well, so the application needs to call it only to reclaim memory while it is not freeing.
+/// Returns the number of arenas unmapped.
+size_t o1heapArenaSetTrim(O1HeapArenaSet* const set);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_ARENA_H_INCLUDED
@@ -0,0 +1,169 @@
+// Per-thread allocation caches layered over o1heap. See o1heap_cache.h.
+
+#include "o1heap_cache.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+#if !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 201112L)
+#    error "Unsupported language: ISO C11 or a newer version is required for thread-local storage."
+#endif
+
+/// The smallest fragment o1heap hands out; mirrors FRAGMENT_SIZE_MIN in o1heap.c.
+#define CACHE_FRAGMENT_SIZE_MIN (O1HEAP_ALIGNMENT * 2U)
+
+/// One size class per power of two from CACHE_FRAGMENT_SIZE_MIN to O1HEAP_CACHE_FRAGMENT_SIZE_MAX inclusive.
+#define CACHE_NUM_CLASSES 8U
+
+#define CACHE_BATCH_SIZE (O1HEAP_CACHE_MAGAZINE_SIZE / 2U)
+
+/// A refill takes at most this fraction of the heap capacity, but at least one fragment.
+#define CACHE_REFILL_CAPACITY_DIVISOR 8U
+
+_Static_assert((O1HEAP_CACHE_FRAGMENT_SIZE_MAX & (O1HEAP_CACHE_FRAGMENT_SIZE_MAX - 1U)) == 0U, "Not a power of 2");
+_Static_assert(O1HEAP_CACHE_FRAGMENT_SIZE_MAX >= CACHE_FRAGMENT_SIZE_MIN, "Cached fragment size too small");
+_Static_assert((O1HEAP_CACHE_FRAGMENT_SIZE_MAX / CACHE_FRAGMENT_SIZE_MIN) < (1U << CACHE_NUM_CLASSES),
+               "Increase CACHE_NUM_CLASSES");
+_Static_assert((CACHE_BATCH_SIZE > 0U) && (O1HEAP_CACHE_MAGAZINE_SIZE <= UINT8_MAX), "Invalid magazine size");
+
+typedef struct
+{
+    O1HeapInstance* owner;     ///< The heap the cached fragments belong to; NULL if nothing is cached.
+    size_t          capacity;  ///< The capacity of the owner, which does not change after its initialization.
+    uint8_t         count[CACHE_NUM_CLASSES];
+    void*           items[CACHE_NUM_CLASSES][O1HEAP_CACHE_MAGAZINE_SIZE];  ///< The most recently freed one is on top.
+} Cache;
+
+static _Thread_local Cache g_cache;
+
+/// Returns the size class of a fragment of the specified size (a power of two), or CACHE_NUM_CLASSES if not cached.
+static inline uint8_t classOfFragment(const size_t fragment_size)
+{
+    uint8_t out = CACHE_NUM_CLASSES;
+    if ((fragment_size >= CACHE_FRAGMENT_SIZE_MIN) && (fragment_size <= O1HEAP_CACHE_FRAGMENT_SIZE_MAX))
+    {
+        out = 0U;
+        for (size_t s = CACHE_FRAGMENT_SIZE_MIN; s < fragment_size; s <<= 1U)
+        {
+            out++;
+        }
+    }
+    return out;
+}
+
+/// Returns the size class that serves the requested amount, or CACHE_NUM_CLASSES if not cached.
+/// o1heap rounds the amount plus the per-fragment overhead up to a power of two; the same is done here.
+static inline uint8_t classOfAmount(const size_t amount)
+{
+    uint8_t out = CACHE_NUM_CLASSES;
+    if ((amount > 0U) && (amount <= (O1HEAP_CACHE_FRAGMENT_SIZE_MAX - O1HEAP_ALIGNMENT)))
+    {
+        size_t fragment_size = CACHE_FRAGMENT_SIZE_MIN;
+        while (fragment_size < (amount + O1HEAP_ALIGNMENT))
+        {
+            fragment_size <<= 1U;
+        }
+        out = classOfFragment(fragment_size);
+    }
+    return out;
+}
+
+/// The largest amount served by the size class; the fragments of the class are allocated with this amount.
+static inline size_t amountOfClass(const uint8_t size_class)
+{
+    return (((size_t) CACHE_FRAGMENT_SIZE_MIN) << size_class) - O1HEAP_ALIGNMENT;
+}
+
+/// Makes the calling thread's cache serve the specified heap, returning the fragments of another heap if necessary.
+static inline void bindToHeap(O1HeapInstance* const handle)
+{
+    if (g_cache.owner != handle)
+    {
+        o1heapCacheFlush();
+        g_cache.owner    = handle;
+        g_cache.capacity = o1heapGetDiagnostics(handle).capacity;
+    }
+}
+
+/// The number of fragments to take from the heap at once for the size class: a small heap would otherwise be taken
+/// up by the magazine of the first thread that allocates, leaving nothing for the other threads.
+static inline size_t refillCountOfClass(const uint8_t size_class)
+{
+    const size_t fragment_size = ((size_t) CACHE_FRAGMENT_SIZE_MIN) << size_class;
+    const size_t affordable    = g_cache.capacity / (fragment_size * CACHE_REFILL_CAPACITY_DIVISOR);
+    return (affordable < 1U) ? 1U : ((affordable > CACHE_BATCH_SIZE) ? CACHE_BATCH_SIZE : affordable);
+}
+
+void* o1heapCacheAllocate(O1HeapInstance* const handle, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    void*         out = NULL;
+    const uint8_t cls = classOfAmount(amount);
+    if (cls < CACHE_NUM_CLASSES)
+    {
+        bindToHeap(handle);
+        if (g_cache.count[cls] == 0U)
+        {
+            g_cache.count[cls] = (uint8_t) o1heapAllocateBatch(handle,  //
+                                                               amountOfClass(cls),
+                                                               &g_cache.items[cls][0],
+                                                               refillCountOfClass(cls));
+        }
+        if (g_cache.count[cls] > 0U)
+        {
+            g_cache.count[cls]--;
+            out = g_cache.items[cls][g_cache.count[cls]];
+        }
+    }
+    else
+    {
+        out = o1heapAllocate(handle, amount);
+    }
+    return out;
+}
+
+void o1heapCacheFree(O1HeapInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (pointer != NULL)
+    {
+        const uint8_t cls = classOfFragment(o1heapGetAllocationSize(handle, pointer) + O1HEAP_ALIGNMENT);
+        if (cls < CACHE_NUM_CLASSES)
+        {
+            bindToHeap(handle);
+            if (g_cache.count[cls] >= O1HEAP_CACHE_MAGAZINE_SIZE)
+            {
+                // Return the older half, which is less likely to be in the CPU cache, and keep the recent one.
+                o1heapFreeBatch(handle, &g_cache.items[cls][0], CACHE_BATCH_SIZE);
+                (void) memmove(&g_cache.items[cls][0],
+                               &g_cache.items[cls][CACHE_BATCH_SIZE],
+                               sizeof(void*) * (O1HEAP_CACHE_MAGAZINE_SIZE - CACHE_BATCH_SIZE));
+                g_cache.count[cls] = (uint8_t) (O1HEAP_CACHE_MAGAZINE_SIZE - CACHE_BATCH_SIZE);
+            }
+            g_cache.items[cls][g_cache.count[cls]] = pointer;
+            g_cache.count[cls]++;
+        }
+        else
+        {
+            o1heapFree(handle, pointer);
+        }
+    }
+}
+
+void o1heapCacheFlush(void)
+{
+    if (g_cache.owner != NULL)
+    {
+        for (uint8_t cls = 0U; cls < CACHE_NUM_CLASSES; cls++)
+        {
+            o1heapFreeBatch(g_cache.owner, &g_cache.items[cls][0], g_cache.count[cls]);
+            g_cache.count[cls] = 0U;
+        }
+        g_cache.owner    = NULL;
+        g_cache.capacity = 0U;
+    }
+}
@@ -0,0 +1,59 @@
+// Per-thread allocation caches layered over o1heap.
+//
+// Every o1heapAllocate()/o1heapFree() call enters the critical section of the heap, which makes the heap a global lock
+// if it is shared by several threads. This layer keeps a small stack of free fragments ("magazine") per thread and per
+// fragment size, so that most allocations and deallocations of small blocks do not touch the shared heap at all;
+// the magazines are refilled from and drained to the heap in batches, one critical section per batch.
+//
+// The heap shall be initialized with the critical section hooks as usual (the heap is shared between threads).
+// Blocks allocated through the cache can be freed from any thread, through the cache or directly with o1heapFree(),
+// and blocks allocated with o1heapAllocate() can be freed through the cache.
+//
+// The fragments held by the magazines count as allocated in the heap diagnostics. A thread shall call
+// o1heapCacheFlush() before it exits, otherwise its cached fragments are lost.
+//
+// A refill takes at most an eighth of the heap capacity, so the first thread to allocate cannot take up a small heap.
+// The caches work best when a thread frees what it allocates. When one thread allocates and another one frees, as the
+// producers calling tx_pump_push() and the TX pump that releases the frames do, the fragments are stranded on both
+// sides: the producer holds up to a batch it took from the heap, and the freeing thread holds up to a magazine
+// before it gives the older half back. That is up to O1HEAP_CACHE_MAGAZINE_SIZE fragments per size class per
+// thread out of reach of the others, which the heap size shall allow for.
+// A thread caches fragments for one heap at a time; using the cache with a different heap flushes it first.
+
+#ifndef O1HEAP_CACHE_H_INCLUDED
+#define O1HEAP_CACHE_H_INCLUDED
+
+#include "o1heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Fragments up to this size (including the per-fragment overhead) are cached; larger requests go to the heap directly.
+/// Shall be a power of two not less than 2*O1HEAP_ALIGNMENT.
+#ifndef O1HEAP_CACHE_FRAGMENT_SIZE_MAX
+#    define O1HEAP_CACHE_FRAGMENT_SIZE_MAX 1024U
+#endif
+
+/// The number of fragments a magazine holds. Half of it is exchanged with the heap at once.
+#ifndef O1HEAP_CACHE_MAGAZINE_SIZE
+#    define O1HEAP_CACHE_MAGAZINE_SIZE 32U
+#endif
+
+/// Same as o1heapAllocate() but served from the magazine of the calling thread if possible.
+/// If the magazine of the size class is empty, it is refilled in one batch of up to half of its capacity.
+/// Returns NULL if the heap cannot serve the request.
+void* o1heapCacheAllocate(O1HeapInstance* const handle, const size_t amount);
+
+/// Same as o1heapFree() but the fragment is kept in the magazine of the calling thread for reuse.
+/// If the magazine is full, its older half is returned to the heap in one batch first.
+void o1heapCacheFree(O1HeapInstance* const handle, void* const pointer);
+
+/// Returns all fragments cached by the calling thread to the heap they came from.
+/// Call this before the thread exits or when the heap diagnostics need to be exact.
+void o1heapCacheFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_CACHE_H_INCLUDED
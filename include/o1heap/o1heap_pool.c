@@ -0,0 +1,160 @@
+// Fixed-size block pools layered over o1heap. See o1heap_pool.h.
+
+#include "o1heap_pool.h"
+#include <assert.h>
+
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+_Static_assert((O1HEAP_POOL_ALIGNMENT & (O1HEAP_POOL_ALIGNMENT - 1U)) == 0U, "Not a power of 2");
+_Static_assert(O1HEAP_POOL_ALIGNMENT >= sizeof(void*), "A free block shall fit the free list link");
+
+static inline size_t roundUpToAlignment(const size_t x)
+{
+    return (x + (O1HEAP_POOL_ALIGNMENT - 1U)) & ~(O1HEAP_POOL_ALIGNMENT - 1U);
+}
+
+/// Returns the index of the pool the block belongs to, or class_count if it was allocated from the fallback heap.
+static inline size_t classOfPointer(const O1HeapPool* const pool, const void* const pointer)
+{
+    size_t i = 0U;
+    while (i < pool->class_count)
+    {
+        const O1HeapPoolClass* const cls = &pool->classes[i];
+        if (((const unsigned char*) pointer >= cls->begin) && ((const unsigned char*) pointer < cls->end))
+        {
+            break;
+        }
+        i++;
+    }
+    return i;
+}
+
+size_t o1heapPoolGetStorageSize(const size_t* const block_sizes, const size_t* const block_counts, const size_t count)
+{
+    size_t out = 0U;
+    if ((block_sizes != NULL) && (block_counts != NULL))
+    {
+        for (size_t i = 0U; i < count; i++)
+        {
+            out += roundUpToAlignment(block_sizes[i]) * block_counts[i];
+        }
+    }
+    return out;
+}
+
+bool o1heapPoolInit(O1HeapPool* const     pool,
+                    void* const           storage,
+                    const size_t          storage_size,
+                    const size_t* const   block_sizes,
+                    const size_t* const   block_counts,
+                    const size_t          count,
+                    O1HeapInstance* const fallback)
+{
+    bool ok = (pool != NULL) && (block_sizes != NULL) && (block_counts != NULL) && (count <= O1HEAP_POOL_CLASSES_MAX) &&
+              (((size_t) storage % O1HEAP_POOL_ALIGNMENT) == 0U) &&
+              (o1heapPoolGetStorageSize(block_sizes, block_counts, count) <= storage_size) &&
+              ((storage != NULL) || (storage_size == 0U));
+    for (size_t i = 1U; ok && (i < count); i++)
+    {
+        ok = roundUpToAlignment(block_sizes[i - 1U]) < roundUpToAlignment(block_sizes[i]);
+    }
+    if (ok)
+    {
+        pool->fallback    = fallback;
+        pool->class_count = count;
+        unsigned char* ptr = (unsigned char*) storage;
+        for (size_t i = 0U; i < count; i++)
+        {
+            O1HeapPoolClass* const cls = &pool->classes[i];
+            cls->block_size            = roundUpToAlignment(block_sizes[i]);
+            cls->block_count           = block_counts[i];
+            cls->in_use                = 0U;
+            cls->peak_in_use           = 0U;
+            cls->fallback_count        = 0U;
+            cls->begin                 = ptr;
+            cls->end                   = ptr + (cls->block_size * cls->block_count);
+            cls->free_list             = NULL;
+            // Link the blocks back to front so that they are handed out in the address order.
+            for (size_t k = cls->block_count; k > 0U; k--)
+            {
+                void* const block = cls->begin + (cls->block_size * (k - 1U));
+                *(void**) block   = cls->free_list;
+                cls->free_list    = block;
+            }
+            ptr = cls->end;
+        }
+    }
+    return ok;
+}
+
+void* o1heapPoolAllocate(O1HeapPool* const pool, const size_t amount)
+{
+    O1HEAP_ASSERT(pool != NULL);
+    void* out = NULL;
+    if (amount > 0U)
+    {
+        O1HeapPoolClass* cls = NULL;
+        for (size_t i = 0U; i < pool->class_count; i++)
+        {
+            if (pool->classes[i].block_size >= amount)
+            {
+                cls = &pool->classes[i];
+                break;
+            }
+        }
+        if ((cls != NULL) && (cls->free_list != NULL))
+        {
+            out            = cls->free_list;
+            cls->free_list = *(void**) out;
+            cls->in_use++;
+            if (cls->peak_in_use < cls->in_use)
+            {
+                cls->peak_in_use = cls->in_use;
+            }
+        }
+        else
+        {
+            if (cls != NULL)
+            {
+                cls->fallback_count++;
+            }
+            if (pool->fallback != NULL)
+            {
+                out = o1heapAllocate(pool->fallback, amount);
+            }
+        }
+    }
+    return out;
+}
+
+void o1heapPoolFree(O1HeapPool* const pool, void* const pointer)
+{
+    O1HEAP_ASSERT(pool != NULL);
+    if (pointer != NULL)
+    {
+        const size_t index = classOfPointer(pool, pointer);
+        if (index < pool->class_count)
+        {
+            O1HeapPoolClass* const cls = &pool->classes[index];
+            O1HEAP_ASSERT((((size_t) ((unsigned char*) pointer - cls->begin)) % cls->block_size) == 0U);
+            O1HEAP_ASSERT(cls->in_use > 0U);
+            *(void**) pointer = cls->free_list;
+            cls->free_list    = pointer;
+            cls->in_use--;
+        }
+        else
+        {
+            O1HEAP_ASSERT(pool->fallback != NULL);
+            o1heapFree(pool->fallback, pointer);
+        }
+    }
+}
+
+bool o1heapPoolOwns(const O1HeapPool* const pool, const void* const pointer)
+{
+    O1HEAP_ASSERT(pool != NULL);
+    return (pointer != NULL) && (classOfPointer(pool, pointer) < pool->class_count);
+}
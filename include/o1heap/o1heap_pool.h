@@ -0,0 +1,87 @@
+// Fixed-size block pools layered over o1heap.
+//
+// o1heap rounds every request plus its per-fragment overhead up to a power of two, which wastes up to half of the
+// fragment for sizes just above a power of two. An application that allocates a handful of known sizes (such as the
+// libcanard TX queue items, RX sessions and RX payload buffers, see canardTxGetItemSize() and friends) can serve
+// them from pools of blocks of exactly those sizes instead. Each pool is a contiguous array of blocks with an
+// intrusive free list, so allocation and deallocation are constant-time and carry no per-block overhead.
+// Requests that fit no pool, and requests for an exhausted pool, are forwarded to the fallback o1heap instance.
+//
+// The pools are not thread-safe; a pool set shared between threads shall be protected by the caller.
+
+#ifndef O1HEAP_POOL_H_INCLUDED
+#define O1HEAP_POOL_H_INCLUDED
+
+#include "o1heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of block sizes in one pool set.
+#ifndef O1HEAP_POOL_CLASSES_MAX
+#    define O1HEAP_POOL_CLASSES_MAX 8U
+#endif
+
+/// Block sizes are rounded up to this alignment, which is also the alignment of the returned pointers.
+/// It matches what malloc() guarantees on the platform rather than O1HEAP_ALIGNMENT, which is larger.
+#define O1HEAP_POOL_ALIGNMENT (sizeof(void*) * 2U)
+
+/// One pool of equally sized blocks. The fields other than the statistics are private.
+typedef struct
+{
+    size_t block_size;      ///< The requested size rounded up to O1HEAP_POOL_ALIGNMENT.
+    size_t block_count;     ///< The number of blocks in the pool.
+    size_t in_use;          ///< The number of blocks currently allocated from the pool.
+    size_t peak_in_use;     ///< The maximum value of in_use seen since initialization.
+    size_t fallback_count;  ///< The number of requests of this class forwarded to the heap because the pool was full.
+
+    unsigned char* begin;
+    unsigned char* end;
+    void*          free_list;
+} O1HeapPoolClass;
+
+typedef struct
+{
+    O1HeapInstance* fallback;  ///< May be NULL, in which case the requests that cannot be pooled fail.
+    size_t          class_count;
+    O1HeapPoolClass classes[O1HEAP_POOL_CLASSES_MAX];
+} O1HeapPool;
+
+/// Returns the amount of storage that o1heapPoolInit() needs for the specified block sizes and counts.
+/// The block sizes are rounded up to O1HEAP_POOL_ALIGNMENT. The storage base shall be aligned at the same value.
+size_t o1heapPoolGetStorageSize(const size_t* const block_sizes, const size_t* const block_counts, const size_t count);
+
+/// Initializes the pool set in the provided storage. The block sizes shall be strictly ascending after rounding up
+/// to O1HEAP_POOL_ALIGNMENT and there shall be at most O1HEAP_POOL_CLASSES_MAX of them.
+/// The storage shall be aligned at O1HEAP_POOL_ALIGNMENT and its size shall not be less than
+/// o1heapPoolGetStorageSize() for the same arguments. The fallback heap may be NULL.
+/// Returns false if the arguments are invalid; the pool set is then unusable. The time complexity is linear from
+/// the total number of blocks.
+bool o1heapPoolInit(O1HeapPool* const     pool,
+                    void* const           storage,
+                    const size_t          storage_size,
+                    const size_t* const   block_sizes,
+                    const size_t* const   block_counts,
+                    const size_t          count,
+                    O1HeapInstance* const fallback);
+
+/// Serves the request from the smallest pool whose block size is not less than the amount. If that pool is
+/// exhausted or no pool is large enough, the request is forwarded to the fallback heap (larger pools are not used
+/// so that a burst of small requests cannot starve them). Returns NULL if the request cannot be served.
+/// The time complexity is linear from the number of pools, which is a small constant.
+void* o1heapPoolAllocate(O1HeapPool* const pool, const size_t amount);
+
+/// Returns the block to the pool it came from, or to the fallback heap if it was not allocated from a pool.
+/// NULL pointers are ignored. The time complexity is linear from the number of pools.
+void o1heapPoolFree(O1HeapPool* const pool, void* const pointer);
+
+/// Returns true if the block was allocated from one of the pools rather than from the fallback heap.
+/// This allows chaining the pools in front of an allocator other than o1heap: initialize them without a fallback,
+/// forward the requests that o1heapPoolAllocate() rejects, and route the frees by this function.
+bool o1heapPoolOwns(const O1HeapPool* const pool, const void* const pointer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_POOL_H_INCLUDED
@@ -1,4 +1,7 @@
 //TODO
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // sendmmsg(), recvmmsg()
+#endif
 #include "socketcan.h"
 
 /* Send CAN data on the bus
@@ -29,11 +32,276 @@ int recv_can_data(int *s, struct can_frame *frame)
     return 0;
 }
 
+/* Send a CAN or CAN FD frame on the bus
+ * s: pointer to socket descriptor
+ * frame: pointer to SocketCAN FD frame struct
+ * mtu: CANFD_MTU to send a CAN FD frame, CAN_MTU to send a classic frame (len <= 8)
+ */
+int send_canfd_data(int *s, struct canfd_frame *frame, size_t mtu)
+{
+    if(write(*s, frame, mtu) != (ssize_t)mtu)
+    {
+        perror("Write");
+        return -1;
+    }
+    return 0;
+}
+
+/* Get the current time of CLOCK_MONOTONIC in microseconds
+ * This is the time base of the timestamps of received frames.
+ */
+uint64_t socketcan_monotonic_usec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+/* Get the difference between CLOCK_REALTIME and CLOCK_MONOTONIC in nanoseconds
+ * The kernel stamps received frames with the real time, which can be stepped by NTP or the user;
+ * the offset is sampled for every receive call to move the stamps to the monotonic time base.
+ */
+static int64_t realtime_to_monotonic_offset(void)
+{
+    struct timespec rt;
+    struct timespec mono;
+    clock_gettime(CLOCK_REALTIME, &rt);
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    return (((int64_t)rt.tv_sec - (int64_t)mono.tv_sec) * 1000000000LL) + ((int64_t)rt.tv_nsec - (int64_t)mono.tv_nsec);
+}
+
+/* Extract the kernel receive timestamp from the ancillary data of a message
+ * msg: the received message
+ * offset_nsec: result of realtime_to_monotonic_offset()
+ * Returns the timestamp in monotonic microseconds, or the current monotonic time if the kernel
+ * did not provide a software timestamp.
+ */
+static uint64_t message_timestamp(struct msghdr *msg, int64_t offset_nsec)
+{
+    struct timespec ts;
+    memset(&ts, 0, sizeof(ts));
+    for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if(cmsg->cmsg_level != SOL_SOCKET)
+        {
+            continue;
+        }
+        if(cmsg->cmsg_type == SCM_TIMESTAMPING)
+        {
+            // ts[0] is the software stamp, ts[2] the raw hardware stamp. The latter is in the time base of
+            // the CAN controller, which differs between interfaces, so only the software stamp is used.
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        }
+        else if(cmsg->cmsg_type == SCM_TIMESTAMPNS)
+        {
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        }
+    }
+    if(ts.tv_sec == 0 && ts.tv_nsec == 0)
+    {
+        return socketcan_monotonic_usec();
+    }
+
+    const int64_t nsec = ((int64_t)ts.tv_sec * 1000000000LL) + (int64_t)ts.tv_nsec - offset_nsec;
+    return (nsec > 0) ? ((uint64_t)nsec / 1000ULL) : 0U;
+}
+
+/* Receive a CAN or CAN FD frame from the bus
+ * s: pointer to socket descriptor
+ * frame: pointer to SocketCAN FD frame struct; classic frames are stored in the same layout
+ * timestamp_usec: receives the kernel receive timestamp in monotonic microseconds (may be NULL)
+ * Returns the number of bytes read (CAN_MTU or CANFD_MTU), or -1 on error.
+ */
+int recv_canfd_data(int *s, struct canfd_frame *frame, uint64_t *timestamp_usec)
+{
+    union
+    {
+        char buf[SOCKETCAN_CMSG_SIZE];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = {.iov_base = frame, .iov_len = CANFD_MTU};
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    ssize_t nbytes = recvmsg(*s, &msg, 0);
+    if(nbytes < 0)
+    {
+        perror("Recvmsg");
+        return -1;
+    }
+    if(nbytes == CAN_MTU)
+    {
+        // The third byte of a classic frame is padding, not FD flags.
+        frame->flags = 0;
+    }
+    else if(nbytes != CANFD_MTU)
+    {
+        fprintf(stderr, "Read: incomplete CAN frame\n");
+        return -1;
+    }
+    if(timestamp_usec != NULL)
+    {
+        *timestamp_usec = message_timestamp(&msg, realtime_to_monotonic_offset());
+    }
+    return (int)nbytes;
+}
+
+/* Receive up to count CAN or CAN FD frames with a single system call
+ * s: pointer to socket descriptor
+ * frames: array of count SocketCAN FD frame structs; classic frames are stored in the same layout
+ * timestamps_usec: array of count entries; receives the kernel receive timestamps in monotonic
+ *                  microseconds (may be NULL)
+ * count: capacity of the arrays, at most SOCKETCAN_BATCH_MAX
+ * wait: true to block until at least one frame is available, false to return immediately
+ * Returns the number of frames received (0 if none are available and wait is false), or -1 on error.
+ */
+int recv_can_batch(int *s, struct canfd_frame *frames, uint64_t *timestamps_usec, size_t count, bool wait)
+{
+    union
+    {
+        char buf[SOCKETCAN_CMSG_SIZE];
+        struct cmsghdr align;
+    } control[SOCKETCAN_BATCH_MAX];
+    struct mmsghdr msgs[SOCKETCAN_BATCH_MAX];
+    struct iovec iovs[SOCKETCAN_BATCH_MAX];
+    if(count > SOCKETCAN_BATCH_MAX)
+    {
+        count = SOCKETCAN_BATCH_MAX;
+    }
+
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for(size_t i = 0; i < count; i++)
+    {
+        iovs[i].iov_base = &frames[i];
+        iovs[i].iov_len = CANFD_MTU;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = control[i].buf;
+        msgs[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+    }
+
+    // MSG_WAITFORONE blocks for the first frame only and then takes whatever else is queued.
+    int n = recvmmsg(*s, msgs, (unsigned int)count, wait ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+    if(n < 0)
+    {
+        if(!wait && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return 0;
+        }
+        perror("Recvmmsg");
+        return -1;
+    }
+
+    // Drop incomplete frames by compacting the array; clear the padding byte of classic frames.
+    const int64_t offset_nsec = realtime_to_monotonic_offset();
+    int out = 0;
+    for(int i = 0; i < n; i++)
+    {
+        if(msgs[i].msg_len == CAN_MTU || msgs[i].msg_len == CANFD_MTU)
+        {
+            if(out != i)
+            {
+                frames[out] = frames[i];
+            }
+            if(msgs[i].msg_len == CAN_MTU)
+            {
+                frames[out].flags = 0;
+            }
+            if(timestamps_usec != NULL)
+            {
+                timestamps_usec[out] = message_timestamp(&msgs[i].msg_hdr, offset_nsec);
+            }
+            out++;
+        }
+    }
+    return out;
+}
+
+/* Send count CAN or CAN FD frames with as few system calls as possible
+ * s: pointer to socket descriptor
+ * frames: array of SocketCAN FD frame structs
+ * count: number of frames to send
+ * mtu: CANFD_MTU to send CAN FD frames, CAN_MTU to send classic frames (len <= 8)
+ * Returns the number of frames sent, which is less than count only if an error occurred.
+ */
+int send_can_batch(int *s, struct canfd_frame *frames, size_t count, size_t mtu)
+{
+    struct mmsghdr msgs[SOCKETCAN_BATCH_MAX];
+    struct iovec iovs[SOCKETCAN_BATCH_MAX];
+    size_t sent = 0;
+    while(sent < count)
+    {
+        const size_t chunk = ((count - sent) < SOCKETCAN_BATCH_MAX) ? (count - sent) : SOCKETCAN_BATCH_MAX;
+        memset(msgs, 0, sizeof(msgs[0]) * chunk);
+        for(size_t i = 0; i < chunk; i++)
+        {
+            iovs[i].iov_base = &frames[sent + i];
+            iovs[i].iov_len = mtu;
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // The kernel may accept only a part of the batch if the TX queue fills up; resend the rest.
+        int n = sendmmsg(*s, msgs, (unsigned int)chunk, 0);
+        if(n <= 0)
+        {
+            perror("Sendmmsg");
+            break;
+        }
+        sent += (size_t)n;
+    }
+    return (int)sent;
+}
+
+/* Replace the acceptance filters of the socket
+ * Only the frames that match at least one filter are delivered; with no filters, no frames are delivered.
+ * A frame matches a filter if (frame.can_id & filter.can_mask) == (filter.can_id & filter.can_mask).
+ * s: pointer to socket descriptor
+ * filters: array of count filters (may be NULL if count is zero)
+ * count: number of filters, at most SOCKETCAN_MAX_FILTERS
+ */
+int set_can_filters(int *s, const struct can_filter *filters, size_t count)
+{
+    if(count > SOCKETCAN_MAX_FILTERS)
+    {
+        fprintf(stderr, "Too many CAN filters: %zu\n", count);
+        return -1;
+    }
+    if(setsockopt(*s, SOL_CAN_RAW, CAN_RAW_FILTER, (count > 0) ? filters : NULL,
+                  (socklen_t)(sizeof(struct can_filter) * count)) < 0)
+    {
+        perror("CAN filter");
+        return -1;
+    }
+    return 0;
+}
+
 /* Open our SocketCAN socket (vcan0)
  * s: pointer to socket descriptor
  */
 int open_can_socket(int *s)
 {
+    return open_can_socket_on(s, "vcan0", NULL);
+}
+
+/* Open a SocketCAN socket bound to the given interface
+ * CAN FD frames are enabled on the socket if the interface supports them.
+ * s: pointer to socket descriptor
+ * ifname: name of the CAN interface, e.g. "vcan0" or "can1"
+ * mtu: receives the MTU of the interface, CAN_MTU or CANFD_MTU (may be NULL)
+ */
+int open_can_socket_on(int *s, const char *ifname, size_t *mtu)
+{
+    if(strlen(ifname) >= IFNAMSIZ)
+    {
+        fprintf(stderr, "Interface name too long: %s\n", ifname);
+        return -1;
+    }
+
     // Open a RAW CAN socket.
     if((*s = socket(PF_CAN, SOCK_RAW, CAN_RAW)) < 0)
     {
@@ -41,23 +309,438 @@ int open_can_socket(int *s)
         return -1;
     }
 
-    // Construct an if request for vcan0 socket.
+    // Construct an if request for the interface.
     struct ifreq ifr;
-    strcpy(ifr.ifr_name, "vcan0");
-    ioctl(*s, SIOCGIFINDEX, &ifr);
+    memset(&ifr, 0, sizeof(ifr));
+    strcpy(ifr.ifr_name, ifname);
+    if(ioctl(*s, SIOCGIFINDEX, &ifr) < 0)
+    {
+        perror(ifname);
+        close(*s);
+        return -1;
+    }
+    const int ifindex = ifr.ifr_ifindex;  // The MTU request below reuses the same union.
+
+    // Use CAN FD if the interface supports it (vcan: "ip link set vcan0 mtu 72").
+    if(ioctl(*s, SIOCGIFMTU, &ifr) < 0)
+    {
+        perror(ifname);
+        close(*s);
+        return -1;
+    }
+    const size_t if_mtu = (ifr.ifr_mtu == (int)CANFD_MTU) ? CANFD_MTU : CAN_MTU;
+    if(if_mtu == CANFD_MTU)
+    {
+        const int enable = 1;
+        if(setsockopt(*s, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0)
+        {
+            perror("CAN FD");
+            close(*s);
+            return -1;
+        }
+    }
+    if(mtu != NULL)
+    {
+        *mtu = if_mtu;
+    }
+
+    // Ask the kernel to stamp received frames. SO_TIMESTAMPING provides hardware stamps as well where
+    // the driver supports them; older kernels only know SO_TIMESTAMPNS. Without either, frames are
+    // stamped in user space when they are read, which is less accurate but not an error.
+    const int stamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                         SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    if(setsockopt(*s, SOL_SOCKET, SO_TIMESTAMPING, &stamping, sizeof(stamping)) < 0)
+    {
+        const int enable = 1;
+        if(setsockopt(*s, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0)
+        {
+            perror("Timestamps");
+        }
+    }
 
     // Create a socket address field for binding.
     struct sockaddr_can addr;
     memset(&addr, 0, sizeof(addr));
     addr.can_family = PF_CAN;
-    addr.can_ifindex = ifr.ifr_ifindex;
+    addr.can_ifindex = ifindex;
 
     // Bind the socket.
     if(bind(*s, (struct sockaddr *)&addr, sizeof(addr)) < 0)
     {
         perror("Bind");
+        close(*s);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Open a redundant transport over several CAN interfaces
+ * t: pointer to the transport to initialize
+ * ifnames: names of the interfaces; the position in this array is the interface index
+ * count: number of interfaces, 1 to SOCKETCAN_MAX_IFACES
+ */
+int socketcan_transport_open(socketcan_transport *t, const char *const *ifnames, size_t count)
+{
+    if(count == 0 || count > SOCKETCAN_MAX_IFACES)
+    {
+        fprintf(stderr, "Unsupported number of interfaces: %zu\n", count);
+        return -1;
+    }
+
+    memset(t, 0, sizeof(*t));
+    if((t->epoll_fd = epoll_create1(0)) < 0)
+    {
+        perror("Epoll");
+        return -1;
+    }
+
+    for(size_t i = 0; i < count; i++)
+    {
+        if(open_can_socket_on(&t->sockets[i], ifnames[i], &t->mtu[i]) < 0)
+        {
+            socketcan_transport_close(t);
+            return -1;
+        }
+        t->iface_count = i + 1;
+
+        // Tag the readiness events with the interface index.
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)i;
+        if(epoll_ctl(t->epoll_fd, EPOLL_CTL_ADD, t->sockets[i], &ev) < 0)
+        {
+            perror("Epoll add");
+            socketcan_transport_close(t);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Receive one CAN frame from whichever interface has data
+ * t: pointer to the transport
+ * frame: pointer to SocketCAN FD frame struct; frame->len is the payload length for classic frames, too
+ * iface_index: receives the index of the interface the frame came from
+ * timestamp_usec: receives the receive timestamp in monotonic microseconds (may be NULL)
+ * timeout_ms: how long to wait for data, -1 to block indefinitely
+ * Returns 1 if a frame was received, 0 on timeout, -1 on error.
+ */
+int socketcan_transport_recv(socketcan_transport *t, struct canfd_frame *frame, uint8_t *iface_index,
+                             uint64_t *timestamp_usec, int timeout_ms)
+{
+    // Serve the interfaces that were already reported ready first so that a busy
+    // interface cannot starve the others.
+    if(t->pending_next >= t->pending_count)
+    {
+        int n = epoll_wait(t->epoll_fd, t->pending, SOCKETCAN_MAX_IFACES, timeout_ms);
+        if(n < 0)
+        {
+            perror("Epoll wait");
+            return -1;
+        }
+        t->pending_count = n;
+        t->pending_next = 0;
+        if(n == 0)
+        {
+            return 0;
+        }
+    }
+
+    const uint32_t index = t->pending[t->pending_next++].data.u32;
+    if(recv_canfd_data(&t->sockets[index], frame, timestamp_usec) < 0)
+    {
+        return -1;
+    }
+    *iface_index = (uint8_t)index;
+    return 1;
+}
+
+/* Send a CAN frame on all interfaces of the transport
+ * The frame goes out as a CAN FD frame on CAN FD interfaces and as a classic frame on the
+ * others; a frame longer than 8 bytes cannot be sent on a classic interface.
+ * t: pointer to the transport
+ * frame: pointer to SocketCAN FD frame struct
+ * Returns the number of interfaces the frame was sent on, or -1 if it could not be sent on any.
+ */
+int socketcan_transport_send(socketcan_transport *t, struct canfd_frame *frame)
+{
+    int sent = 0;
+    for(size_t i = 0; i < t->iface_count; i++)
+    {
+        struct canfd_frame out = *frame;
+        if(t->mtu[i] == CANFD_MTU)
+        {
+            out.flags |= t->fd_flags;
+        }
+        else if(out.len <= CAN_MAX_DLEN)
+        {
+            out.flags = 0;  // Padding in a classic frame.
+        }
+        else
+        {
+            fprintf(stderr, "Frame of %d bytes does not fit interface %zu\n", out.len, i);
+            continue;
+        }
+
+        // A failure on one interface does not prevent sending on the others; this is what redundancy is for.
+        if(send_canfd_data(&t->sockets[i], &out, t->mtu[i]) == 0)
+        {
+            sent++;
+        }
+    }
+    return (sent > 0) ? sent : -1;
+}
+
+/* Receive up to count frames from the interfaces that have data
+ * Waits for at least one interface to become readable, then drains the readable interfaces
+ * in turn with recvmmsg() until the array is full.
+ * t: pointer to the transport
+ * frames: array of count SocketCAN FD frame structs
+ * iface_indices: array of count entries; receives the index of the interface each frame came from
+ * timestamps_usec: array of count entries; receives the receive timestamps in monotonic microseconds (may be NULL)
+ * count: capacity of the arrays
+ * timeout_ms: how long to wait for data, -1 to block indefinitely
+ * Returns the number of frames received, 0 on timeout, -1 on error.
+ */
+int socketcan_transport_recv_batch(socketcan_transport *t, struct canfd_frame *frames, uint8_t *iface_indices,
+                                   uint64_t *timestamps_usec, size_t count, int timeout_ms)
+{
+    if(t->pending_next >= t->pending_count)
+    {
+        int n = epoll_wait(t->epoll_fd, t->pending, SOCKETCAN_MAX_IFACES, timeout_ms);
+        if(n < 0)
+        {
+            perror("Epoll wait");
+            return -1;
+        }
+        t->pending_count = n;
+        t->pending_next = 0;
+    }
+
+    size_t received = 0;
+    while(t->pending_next < t->pending_count && received < count)
+    {
+        const uint32_t index = t->pending[t->pending_next].data.u32;
+        int n = recv_can_batch(&t->sockets[index], &frames[received],
+                               (timestamps_usec != NULL) ? &timestamps_usec[received] : NULL,
+                               count - received, false);
+        if(n < 0)
+        {
+            return -1;
+        }
+        for(int i = 0; i < n; i++)
+        {
+            iface_indices[received + (size_t)i] = (uint8_t)index;
+        }
+        received += (size_t)n;
+
+        // Move on to the next interface once this one is drained. If the array filled up first,
+        // it is served again on the next call; epoll will report it again if it still has data.
+        t->pending_next++;
+    }
+    return (int)received;
+}
+
+/* Send count frames on all interfaces of the transport
+ * Same as socketcan_transport_send() for each frame, but using one sendmmsg() per interface
+ * for up to SOCKETCAN_BATCH_MAX frames. The interfaces are independent: one that fails stops
+ * taking frames, the others carry on, so each of them may have sent a different number.
+ * Frames that an interface cannot carry (more than 8 bytes on a classic CAN interface) are
+ * skipped and counted as sent, as in socketcan_transport_try_send().
+ * t: pointer to the transport
+ * frames: array of SocketCAN FD frame structs
+ * count: number of frames
+ * sent_per_iface: if not NULL, receives the number of frames sent on each interface, iface_count entries;
+ *                 the frames past that number were not sent on that interface and may be retried there
+ * Returns the largest number of frames sent on any interface, which is the number of frames that
+ * reached at least one bus, or -1 if no interface could send anything.
+ */
+int socketcan_transport_send_batch(socketcan_transport *t, struct canfd_frame *frames, size_t count,
+                                   size_t *sent_per_iface)
+{
+    struct canfd_frame out[SOCKETCAN_BATCH_MAX];
+    size_t source[SOCKETCAN_BATCH_MAX];  // Index in the chunk of each frame in out
+    int result = -1;
+    for(size_t i = 0; i < t->iface_count; i++)
+    {
+        size_t sent = 0;
+        for(size_t base = 0; base < count; base += SOCKETCAN_BATCH_MAX)
+        {
+            // Adjust the flags for the interface; drop frames that the interface cannot carry.
+            const size_t chunk = ((count - base) < SOCKETCAN_BATCH_MAX) ? (count - base) : SOCKETCAN_BATCH_MAX;
+            size_t n = 0;
+            for(size_t k = 0; k < chunk; k++)
+            {
+                out[n] = frames[base + k];
+                if(t->mtu[i] == CANFD_MTU)
+                {
+                    out[n].flags |= t->fd_flags;
+                }
+                else if(out[n].len <= CAN_MAX_DLEN)
+                {
+                    out[n].flags = 0;
+                }
+                else
+                {
+                    fprintf(stderr, "Frame of %d bytes does not fit interface %zu\n", out[n].len, i);
+                    continue;
+                }
+                source[n] = k;
+                n++;
+            }
+            const size_t k = (size_t)send_can_batch(&t->sockets[i], out, n, t->mtu[i]);
+            if(k < n)
+            {
+                sent += source[k];  // The skipped frames before the first one not sent count as sent.
+                break;  // This interface failed; the others may still work.
+            }
+            sent += chunk;
+        }
+        if(sent_per_iface != NULL)
+        {
+            sent_per_iface[i] = sent;
+        }
+        if(sent > 0 && (result < 0 || sent > (size_t)result))
+        {
+            result = (int)sent;
+        }
+    }
+    return result;
+}
+
+/* Send frames on one interface of the transport without blocking
+ * Makes a single sendmmsg() call. Frames that the interface cannot carry (more than 8 bytes on
+ * a classic CAN interface) are skipped and counted as sent.
+ * t: pointer to the transport
+ * iface_index: index of the interface
+ * frames: array of SocketCAN FD frame structs
+ * count: number of frames; at most SOCKETCAN_BATCH_MAX are sent per call
+ * Returns the number of frames consumed from the array, 0 if the socket cannot take any frames now
+ * (wait for EPOLLOUT), or -1 on error.
+ */
+int socketcan_transport_try_send(socketcan_transport *t, size_t iface_index, const struct canfd_frame *frames,
+                                 size_t count)
+{
+    struct canfd_frame out[SOCKETCAN_BATCH_MAX];
+    size_t source[SOCKETCAN_BATCH_MAX];  // Index in frames of each frame in out
+    struct mmsghdr msgs[SOCKETCAN_BATCH_MAX];
+    struct iovec iovs[SOCKETCAN_BATCH_MAX];
+    const size_t mtu = t->mtu[iface_index];
+    if(count > SOCKETCAN_BATCH_MAX)
+    {
+        count = SOCKETCAN_BATCH_MAX;
+    }
+
+    size_t n = 0;
+    for(size_t k = 0; k < count; k++)
+    {
+        out[n] = frames[k];
+        if(mtu == CANFD_MTU)
+        {
+            out[n].flags |= t->fd_flags;
+        }
+        else if(out[n].len <= CAN_MAX_DLEN)
+        {
+            out[n].flags = 0;
+        }
+        else
+        {
+            continue;
+        }
+        source[n] = k;
+        n++;
+    }
+    if(n == 0)
+    {
+        return (int)count;
+    }
+
+    memset(msgs, 0, sizeof(msgs[0]) * n);
+    for(size_t i = 0; i < n; i++)
+    {
+        iovs[i].iov_base = &out[i];
+        iovs[i].iov_len = mtu;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int sent = sendmmsg(t->sockets[iface_index], msgs, (unsigned int)n, MSG_DONTWAIT);
+    if(sent < 0)
+    {
+        // A full TX queue is reported as ENOBUFS by CAN drivers, and as EAGAIN by the socket itself.
+        if(errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        {
+            return 0;
+        }
+        perror("Sendmmsg");
         return -1;
     }
+    return ((size_t)sent == n) ? (int)count : (int)source[sent];
+}
 
+/* Replace the acceptance filters on all interfaces of the transport
+ * See set_can_filters().
+ */
+int socketcan_transport_set_filters(socketcan_transport *t, const struct can_filter *filters, size_t count)
+{
+    for(size_t i = 0; i < t->iface_count; i++)
+    {
+        if(set_can_filters(&t->sockets[i], filters, count) < 0)
+        {
+            return -1;
+        }
+    }
     return 0;
 }
+
+/* Enable or disable the bit rate switch for CAN FD frames sent by the transport
+ * t: pointer to the transport
+ * enable: true to transmit the data phase at the second (higher) bit rate
+ */
+void socketcan_transport_set_brs(socketcan_transport *t, bool enable)
+{
+    if(enable)
+    {
+        t->fd_flags |= CANFD_BRS;
+    }
+    else
+    {
+        t->fd_flags &= (uint8_t)~CANFD_BRS;
+    }
+}
+
+/* Largest frame payload that can be sent on every interface of the transport
+ * Use it as the MTU of the Libcanard instance.
+ * t: pointer to the transport
+ * Returns CANFD_MAX_DLEN (64) if all interfaces are CAN FD capable, CAN_MAX_DLEN (8) otherwise.
+ */
+size_t socketcan_transport_payload_mtu(const socketcan_transport *t)
+{
+    for(size_t i = 0; i < t->iface_count; i++)
+    {
+        if(t->mtu[i] != CANFD_MTU)
+        {
+            return CAN_MAX_DLEN;
+        }
+    }
+    return CANFD_MAX_DLEN;
+}
+
+/* Close all sockets of the transport
+ * t: pointer to the transport
+ */
+void socketcan_transport_close(socketcan_transport *t)
+{
+    for(size_t i = 0; i < t->iface_count; i++)
+    {
+        close(t->sockets[i]);
+    }
+    if(t->epoll_fd >= 0)
+    {
+        close(t->epoll_fd);
+    }
+    t->iface_count = 0;
+    t->epoll_fd = -1;
+}
@@ -1,16 +1,81 @@
 //TODO
+#ifndef SOCKETCAN_H
+#define SOCKETCAN_H
+
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
+
+// Maximum number of redundant interfaces handled by one transport
+#define SOCKETCAN_MAX_IFACES 4
+
+// Maximum number of frames moved by one sendmmsg()/recvmmsg() call
+#define SOCKETCAN_BATCH_MAX 32
+
+// Maximum number of acceptance filters installed on a socket. The kernel checks every filter for every frame,
+// so a few wide filters are cheaper than many exact ones.
+#define SOCKETCAN_MAX_FILTERS 16
+
+// Ancillary data space for one received frame: an SCM_TIMESTAMPING message carries three timestamps
+#define SOCKETCAN_CMSG_SIZE CMSG_SPACE(sizeof(struct timespec) * 3U)
 
+/* A set of redundant CAN interfaces used as a single UAVCAN transport.
+ * Every frame sent is fanned out to all interfaces; received frames are tagged
+ * with the index of the interface they came from so that it can be passed to
+ * canardRxAccept() as the redundant_transport_index.
+ * Interfaces whose MTU is CANFD_MTU are used in CAN FD mode, the others in
+ * classic CAN mode; frames are exchanged as struct canfd_frame in both cases.
+ */
+typedef struct
+{
+    int epoll_fd;
+    int sockets[SOCKETCAN_MAX_IFACES];
+    size_t mtu[SOCKETCAN_MAX_IFACES];  // CAN_MTU or CANFD_MTU
+    size_t iface_count;
+    uint8_t fd_flags;                  // Added to every CAN FD frame sent, e.g. CANFD_BRS
+
+    // Readiness events returned by epoll but not consumed yet
+    struct epoll_event pending[SOCKETCAN_MAX_IFACES];
+    int pending_count;
+    int pending_next;
+} socketcan_transport;
+
+uint64_t socketcan_monotonic_usec(void);
 int open_can_socket(int *s);
+int open_can_socket_on(int *s, const char *ifname, size_t *mtu);
 int recv_can_data(int *s, struct can_frame *frame);
-int send_can_data(int *s, struct can_frame *frame);
\ No newline at end of file
+int send_can_data(int *s, struct can_frame *frame);
+int recv_canfd_data(int *s, struct canfd_frame *frame, uint64_t *timestamp_usec);
+int send_canfd_data(int *s, struct canfd_frame *frame, size_t mtu);
+int recv_can_batch(int *s, struct canfd_frame *frames, uint64_t *timestamps_usec, size_t count, bool wait);
+int send_can_batch(int *s, struct canfd_frame *frames, size_t count, size_t mtu);
+int set_can_filters(int *s, const struct can_filter *filters, size_t count);
+
+int socketcan_transport_open(socketcan_transport *t, const char *const *ifnames, size_t count);
+int socketcan_transport_recv(socketcan_transport *t, struct canfd_frame *frame, uint8_t *iface_index,
+                             uint64_t *timestamp_usec, int timeout_ms);
+int socketcan_transport_send(socketcan_transport *t, struct canfd_frame *frame);
+int socketcan_transport_recv_batch(socketcan_transport *t, struct canfd_frame *frames, uint8_t *iface_indices,
+                                   uint64_t *timestamps_usec, size_t count, int timeout_ms);
+int socketcan_transport_send_batch(socketcan_transport *t, struct canfd_frame *frames, size_t count,
+                                   size_t *sent_per_iface);
+int socketcan_transport_try_send(socketcan_transport *t, size_t iface_index, const struct canfd_frame *frames,
+                                 size_t count);
+int socketcan_transport_set_filters(socketcan_transport *t, const struct can_filter *filters, size_t count);
+void socketcan_transport_set_brs(socketcan_transport *t, bool enable);
+size_t socketcan_transport_payload_mtu(const socketcan_transport *t);
+void socketcan_transport_close(socketcan_transport *t);
+
+#endif  // SOCKETCAN_H
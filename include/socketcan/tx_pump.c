@@ -0,0 +1,332 @@
+#include "tx_pump.h"
+
+/* Drop the expired transfers and stage frames from the queue, up to SOCKETCAN_BATCH_MAX ahead of
+ * the interface that is furthest along
+ * An interface that is TX_PUMP_STAGING_CAPACITY frames behind the next one to stage loses its oldest
+ * staged frame for every new one, so that it cannot hold up the others.
+ */
+static void stage_frames(tx_pump *p)
+{
+    size_t lead = 0;  // How far the most advanced interface is behind the head
+    for(size_t i = 0; i < p->transport->iface_count; i++)
+    {
+        const size_t behind = p->staged_head - p->sent[i];
+        lead = ((i == 0) || (behind < lead)) ? behind : lead;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    if(p->ring != NULL)
+    {
+        (void)tx_ring_drain(p->ring, p->ins);
+    }
+    const int32_t expired = canardTxExpire(p->ins, socketcan_monotonic_usec(), NULL);
+    if(expired > 0)
+    {
+        p->frames_expired += (uint64_t)expired;
+    }
+
+    const size_t first = p->staged_head;
+    for(const CanardFrame *txf = NULL; (lead < SOCKETCAN_BATCH_MAX) && ((txf = canardTxPeek(p->ins)) != NULL); lead++)
+    {
+        for(size_t i = 0; i < p->transport->iface_count; i++)
+        {
+            if(p->staged_head - p->sent[i] >= TX_PUMP_STAGING_CAPACITY)
+            {
+                p->sent[i]++;
+                p->frames_overrun++;
+            }
+        }
+
+        // Libcanard pads the payload to a length that has a valid DLC, so it can be used as the frame length.
+        const size_t index = p->staged_head % TX_PUMP_STAGING_CAPACITY;
+        struct canfd_frame *frame = &p->staged[index];
+        memset(frame, 0, sizeof(*frame));
+        frame->can_id = txf->extended_can_id | CAN_EFF_FLAG;
+        frame->len = (uint8_t)txf->payload_size;
+        memcpy(&frame->data[0], txf->payload, txf->payload_size);
+        p->deadlines_usec[index] = txf->timestamp_usec;
+        p->staged_head++;
+
+        canardTxPop(p->ins);
+        canardTxFree(p->ins, txf);
+    }
+    pthread_mutex_unlock(&p->lock);
+    p->frames_staged += p->staged_head - first;
+}
+
+/* Check whether any interface has staged frames left to send */
+static bool has_staged(const tx_pump *p)
+{
+    bool out = false;
+    for(size_t i = 0; i < p->transport->iface_count; i++)
+    {
+        out = out || (p->sent[i] != p->staged_head);
+    }
+    return out;
+}
+
+/* Drop the expired frames at the head of the backlog of an interface
+ * The staged frames are in the order of the queue rather than of the deadlines, so a frame that
+ * expires behind a valid one is dropped once it reaches the head.
+ * Returns the number of valid frames that follow without wrapping around the end of the ring,
+ * which can be sent in one go.
+ */
+static size_t expire_staged(tx_pump *p, size_t iface_index)
+{
+    const uint64_t now_usec = socketcan_monotonic_usec();
+    size_t *const next = &p->sent[iface_index];
+    while((*next != p->staged_head) && (p->deadlines_usec[*next % TX_PUMP_STAGING_CAPACITY] < now_usec))
+    {
+        (*next)++;
+        p->frames_expired++;
+    }
+    const size_t index = *next % TX_PUMP_STAGING_CAPACITY;
+    size_t count = 0;
+    while((*next + count != p->staged_head) && (index + count < TX_PUMP_STAGING_CAPACITY) &&
+          (p->deadlines_usec[index + count] >= now_usec))
+    {
+        count++;
+    }
+    return count;
+}
+
+/* Send as much of the staging area as the interfaces will take
+ * The deadlines are checked before every send, so a backlog that an interface cannot send expires.
+ * Returns the number of interfaces that could not take all of it.
+ */
+static size_t send_staged(tx_pump *p)
+{
+    size_t blocked = 0;
+    for(size_t i = 0; i < p->transport->iface_count; i++)
+    {
+        for(size_t count = expire_staged(p, i); count > 0; count = expire_staged(p, i))
+        {
+            int n = socketcan_transport_try_send(p->transport, i,
+                                                 &p->staged[p->sent[i] % TX_PUMP_STAGING_CAPACITY], count);
+            if(n < 0)
+            {
+                // Give up on this interface for the current backlog; the redundant ones may still work.
+                p->send_errors++;
+                p->sent[i] = p->staged_head;
+            }
+            else if(n == 0)
+            {
+                break;
+            }
+            else
+            {
+                p->sent[i] += (size_t)n;
+            }
+        }
+        blocked += (p->sent[i] != p->staged_head) ? 1U : 0U;
+    }
+    return blocked;
+}
+
+/* Initialize a TX pump
+ * p: pointer to the pump
+ * ins: Libcanard instance whose TX queue is served
+ * t: open transport to send the frames on
+ */
+int tx_pump_init(tx_pump *p, CanardInstance *ins, socketcan_transport *t)
+{
+    memset(p, 0, sizeof(*p));
+    p->ins = ins;
+    p->transport = t;
+    p->event_fd = -1;
+    p->epoll_fd = -1;
+    atomic_init(&p->stop, false);
+    atomic_init(&p->idle, false);
+    if(pthread_mutex_init(&p->lock, NULL) != 0)
+    {
+        fprintf(stderr, "Mutex init failed\n");
+        return -1;
+    }
+
+    if((p->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+    {
+        perror("Eventfd");
+        tx_pump_close(p);
+        return -1;
+    }
+    if((p->epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+    {
+        perror("Epoll");
+        tx_pump_close(p);
+        return -1;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    if(epoll_ctl(p->epoll_fd, EPOLL_CTL_ADD, p->event_fd, &ev) < 0)
+    {
+        perror("Epoll add");
+        tx_pump_close(p);
+        return -1;
+    }
+    return 0;
+}
+
+/* Run the pump until tx_pump_stop() is called and the queue is empty
+ * Call this from a dedicated thread.
+ * Returns 0 when stopped, -1 on error.
+ */
+int tx_pump_run(tx_pump *p)
+{
+    struct epoll_event event;
+    for(;;)
+    {
+        // Stage more frames as the interfaces get through them; each one proceeds at its own pace.
+        stage_frames(p);
+        const bool pending = has_staged(p);
+        if(!pending && atomic_load(&p->stop))
+        {
+            return 0;
+        }
+
+        // Keep going while the interfaces take everything; sleep once the queue is empty,
+        // or for a while if an interface is full.
+        size_t blocked = 0;
+        if(pending)
+        {
+            blocked = send_staged(p);
+            if(blocked == 0)
+            {
+                continue;
+            }
+        }
+
+        // Before sleeping with nothing to send, announce it and look at the ring once more: a transfer
+        // submitted before the announcement is seen here, one submitted after it comes with a wakeup.
+        if(!pending && p->ring != NULL)
+        {
+            atomic_store(&p->idle, true);
+            atomic_thread_fence(memory_order_seq_cst);  // Pairs with the fence in tx_pump_submit().
+            if(!tx_ring_is_empty(p->ring))
+            {
+                atomic_store(&p->idle, false);
+                continue;
+            }
+        }
+        int n = epoll_wait(p->epoll_fd, &event, 1, (blocked > 0) ? TX_PUMP_RETRY_MS : -1);
+        atomic_store(&p->idle, false);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            perror("Epoll wait");
+            return -1;
+        }
+        p->wakeups++;
+        if(n > 0)
+        {
+            // Reset the counter. EAGAIN means that it has been reset already, which is harmless.
+            uint64_t value;
+            if(read(p->event_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+            {
+                perror("Eventfd read");
+                return -1;
+            }
+        }
+    }
+}
+
+/* Wake the pump up after pushing transfers to the queue
+ * Returns 0 on success, -1 on error.
+ */
+int tx_pump_notify(tx_pump *p)
+{
+    const uint64_t one = 1;
+    if(write(p->event_fd, &one, sizeof(one)) != (ssize_t)sizeof(one))
+    {
+        perror("Eventfd write");
+        return -1;
+    }
+    return 0;
+}
+
+/* Push a transfer to the queue of the pump and wake the pump up
+ * Same as canardTxPush() followed by tx_pump_notify(), but safe to call from any thread.
+ * Returns the result of canardTxPush().
+ */
+int32_t tx_pump_push(tx_pump *p, const CanardTransfer *transfer)
+{
+    pthread_mutex_lock(&p->lock);
+    const int32_t result = canardTxPush(p->ins, transfer);
+    pthread_mutex_unlock(&p->lock);
+    if(result > 0)
+    {
+        (void)tx_pump_notify(p);
+    }
+    return result;
+}
+
+/* Attach a ring of submitted transfers to the pump; call before tx_pump_run()
+ * ring: an initialized ring, or NULL to detach
+ */
+void tx_pump_set_ring(tx_pump *p, tx_ring *ring)
+{
+    p->ring = ring;
+}
+
+/* Submit a transfer through the ring of the pump without taking the lock
+ * Callable from any number of threads at once; the transfer is pushed to the instance by the pump thread.
+ * The pump is woken up only if it is going to sleep, so a burst of submissions costs one system call.
+ * Returns the result of tx_ring_push(): 0 on success, -1 if the ring is full, -2 if the payload is too large;
+ * or -3 if no ring is attached (see tx_pump_set_ring()).
+ */
+int tx_pump_submit(tx_pump *p, const CanardTransfer *transfer)
+{
+    if(p->ring == NULL)
+    {
+        return -3;
+    }
+    const int result = tx_ring_push(p->ring, transfer);
+    atomic_thread_fence(memory_order_seq_cst);  // Order the publication before reading the idle flag.
+    if(result == 0 && atomic_exchange(&p->idle, false))
+    {
+        (void)tx_pump_notify(p);
+    }
+    return result;
+}
+
+/* Take exclusive access to the Libcanard instance of the pump
+ * Use this for any access to the instance outside of tx_pump_push(). Do not call other pump
+ * functions that take the lock (tx_pump_push()) while holding it.
+ */
+void tx_pump_lock(tx_pump *p)
+{
+    pthread_mutex_lock(&p->lock);
+}
+
+/* Release the Libcanard instance locked by tx_pump_lock() */
+void tx_pump_unlock(tx_pump *p)
+{
+    pthread_mutex_unlock(&p->lock);
+}
+
+/* Ask the pump to return from tx_pump_run() once the queue is empty */
+int tx_pump_stop(tx_pump *p)
+{
+    atomic_store(&p->stop, true);
+    return tx_pump_notify(p);
+}
+
+/* Release the resources of the pump; the transport is not closed */
+void tx_pump_close(tx_pump *p)
+{
+    pthread_mutex_destroy(&p->lock);
+    if(p->epoll_fd >= 0)
+    {
+        close(p->epoll_fd);
+        p->epoll_fd = -1;
+    }
+    if(p->event_fd >= 0)
+    {
+        close(p->event_fd);
+        p->event_fd = -1;
+    }
+}
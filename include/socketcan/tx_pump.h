@@ -0,0 +1,78 @@
+#ifndef TX_PUMP_H
+#define TX_PUMP_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <libcanard/canard.h>
+#include "socketcan.h"
+#include "tx_ring.h"
+
+/* Moves the frames of a Libcanard TX queue to a SocketCAN transport.
+ * The pump runs in its own thread and sleeps until a transfer is pushed (the pushing
+ * thread calls tx_pump_notify()). An interface whose TX queue is full (ENOBUFS) is retried
+ * every TX_PUMP_RETRY_MS; CAN sockets report EPOLLOUT even then, so it cannot be waited for.
+ * Frames stay in the Libcanard queue, where newer transfers of higher priority can overtake
+ * them, until the kernel can accept them: they are staged at most SOCKETCAN_BATCH_MAX ahead
+ * of the interface that is furthest along. Every interface has its own position in the
+ * staging area, so a slow or dead redundant interface does not hold up the others; once it
+ * falls TX_PUMP_STAGING_CAPACITY frames behind, its oldest frames are dropped (overrun).
+ * Frames whose deadline (CanardFrame.timestamp_usec, see socketcan_monotonic_usec())
+ * has passed are dropped before they are staged, and before every attempt to send them.
+ * tx_pump_stop() waits for the interface that is furthest behind, at most until the
+ * deadlines of its staged frames.
+ * Libcanard does not synchronize access to the instance, so the pump guards it with a mutex:
+ * other threads push transfers with tx_pump_push(), and wrap any other use of the instance
+ * (e.g. canardRxAccept() on the same instance) in tx_pump_lock()/tx_pump_unlock().
+ * The pump holds the mutex only while it moves frames to the staging area, never while it
+ * waits or sends. If the instance allocates from an o1heap shared with other threads, give
+ * o1heapInit() critical section hooks as well.
+ * Alternatively, producers submit transfers with tx_pump_submit() through a lock-free ring
+ * (see tx_pump_set_ring()), which the pump drains into the instance; a producer that is
+ * preempted then cannot hold up the others, and they do not wait for the pump either.
+ */
+// How long to wait before retrying an interface whose TX queue was full
+#define TX_PUMP_RETRY_MS 1
+
+// Frames an interface may fall behind the one furthest along before it loses the oldest ones; a power of two
+#define TX_PUMP_STAGING_CAPACITY (SOCKETCAN_BATCH_MAX * 4)
+
+typedef struct
+{
+    CanardInstance *ins;
+    socketcan_transport *transport;
+    int event_fd;      // Signaled by tx_pump_notify() and tx_pump_stop()
+    int epoll_fd;      // Waits for event_fd
+    atomic_bool stop;
+    pthread_mutex_t lock;  // Guards the Libcanard instance
+    tx_ring *ring;         // Transfers submitted without the lock; may be NULL
+    atomic_bool idle;      // The pump is about to sleep; the next submitter has to wake it up
+
+    // Ring of the frames taken off the queue with their deadlines. The positions count all frames
+    // ever staged and wrap around the capacity: staged_head is the position of the next frame to
+    // stage, sent[i] that of the next frame for interface i (those before are sent, failed or dropped).
+    struct canfd_frame staged[TX_PUMP_STAGING_CAPACITY];
+    uint64_t deadlines_usec[TX_PUMP_STAGING_CAPACITY];
+    size_t staged_head;
+    size_t sent[SOCKETCAN_MAX_IFACES];
+
+    // Statistics
+    uint64_t frames_staged;   // Frames taken off the queue to be sent
+    uint64_t frames_expired;  // Frames dropped because their deadline passed; once per interface if staged
+    uint64_t frames_overrun;  // Frames dropped on an interface that fell too far behind, once per interface
+    uint64_t send_errors;     // Failed send calls; the frames are dropped on that interface
+    uint64_t wakeups;
+} tx_pump;
+
+int tx_pump_init(tx_pump *p, CanardInstance *ins, socketcan_transport *t);
+int tx_pump_run(tx_pump *p);
+int tx_pump_notify(tx_pump *p);
+int32_t tx_pump_push(tx_pump *p, const CanardTransfer *transfer);
+void tx_pump_set_ring(tx_pump *p, tx_ring *ring);
+int tx_pump_submit(tx_pump *p, const CanardTransfer *transfer);
+void tx_pump_lock(tx_pump *p);
+void tx_pump_unlock(tx_pump *p);
+int tx_pump_stop(tx_pump *p);
+void tx_pump_close(tx_pump *p);
+
+#endif  // TX_PUMP_H
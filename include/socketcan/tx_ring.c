@@ -0,0 +1,118 @@
+#include "tx_ring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Initialize a ring over the slots provided by the application
+ * r: pointer to the ring
+ * slots: array of capacity slots; it shall outlive the ring
+ * capacity: number of slots, a power of two
+ * Returns 0 on success, -1 if the capacity is not a power of two.
+ */
+int tx_ring_init(tx_ring *r, tx_ring_slot *slots, size_t capacity)
+{
+    if(slots == NULL || capacity < 2 || (capacity & (capacity - 1)) != 0)
+    {
+        fprintf(stderr, "Invalid TX ring capacity: %zu\n", capacity);
+        return -1;
+    }
+    memset(r, 0, sizeof(*r));
+    r->slots = slots;
+    r->mask = capacity - 1;
+    for(size_t i = 0; i < capacity; i++)
+    {
+        atomic_init(&slots[i].sequence, i);
+    }
+    atomic_init(&r->head, 0);
+    r->tail = 0;
+    return 0;
+}
+
+/* Submit a transfer; callable from any number of threads at once
+ * The transfer and its payload are copied, so the caller may reuse them on return.
+ * The function does not block; a producer only retries when another one claimed the same
+ * position first, which means that the ring as a whole made progress.
+ * Returns 0 on success, -1 if the ring is full, -2 if the payload exceeds TX_RING_PAYLOAD_MAX.
+ */
+int tx_ring_push(tx_ring *r, const CanardTransfer *transfer)
+{
+    if(transfer->payload_size > TX_RING_PAYLOAD_MAX)
+    {
+        return -2;
+    }
+
+    tx_ring_slot *slot = NULL;
+    size_t pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+    for(;;)
+    {
+        slot = &r->slots[pos & r->mask];
+        const size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if(diff == 0)
+        {
+            // The slot is free; claim the position. On failure pos is reloaded and we retry.
+            if(atomic_compare_exchange_weak_explicit(&r->head, &pos, pos + 1, memory_order_relaxed,
+                                                     memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            return -1;  // The consumer has not drained this slot since the last lap.
+        }
+        else
+        {
+            pos = atomic_load_explicit(&r->head, memory_order_relaxed);  // Another producer got ahead.
+        }
+    }
+
+    slot->transfer = *transfer;
+    slot->transfer.payload = NULL;
+    if(transfer->payload_size > 0)
+    {
+        memcpy(slot->payload, transfer->payload, transfer->payload_size);
+    }
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);  // Publish to the consumer.
+    return 0;
+}
+
+/* Check whether the consumer has nothing to drain; call from the consumer thread only */
+bool tx_ring_is_empty(const tx_ring *r)
+{
+    const tx_ring_slot *slot = &r->slots[r->tail & r->mask];
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) != (r->tail + 1);
+}
+
+/* Push the submitted transfers to the Libcanard TX queue; call from the consumer thread only
+ * Drains at most one lap of the ring so that busy producers cannot keep the consumer here forever.
+ * A slot claimed by a producer that has not finished copying yet ends the drain; it is taken
+ * on the next call.
+ * ins: the instance, which the caller shall have exclusive access to
+ * Returns the number of transfers taken from the ring, including those canardTxPush() rejected.
+ */
+size_t tx_ring_drain(tx_ring *r, CanardInstance *ins)
+{
+    size_t count = 0;
+    while(count <= r->mask)
+    {
+        tx_ring_slot *slot = &r->slots[r->tail & r->mask];
+        if(atomic_load_explicit(&slot->sequence, memory_order_acquire) != (r->tail + 1))
+        {
+            break;
+        }
+
+        slot->transfer.payload = slot->payload;
+        if(canardTxPush(ins, &slot->transfer) < 0)
+        {
+            r->push_errors++;
+        }
+
+        // canardTxPush() copied the payload into the frames, so the slot can be reused for the next lap.
+        atomic_store_explicit(&slot->sequence, r->tail + r->mask + 1, memory_order_release);
+        r->tail++;
+        count++;
+    }
+    r->transfers_drained += count;
+    return count;
+}
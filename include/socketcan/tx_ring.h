@@ -0,0 +1,52 @@
+#ifndef TX_RING_H
+#define TX_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <libcanard/canard.h>
+
+// Maximum payload size of a transfer submitted through the ring; the payload is copied into the slot
+#define TX_RING_PAYLOAD_MAX 256
+
+// Cache line size assumed for keeping the producer and consumer indices apart
+#define TX_RING_CACHE_LINE 64
+
+/* One entry of the ring. The sequence number tells whether the slot is free for the producer
+ * that claims the position or holds a transfer for the consumer.
+ */
+typedef struct
+{
+    atomic_size_t sequence;
+    CanardTransfer transfer;  // transfer.payload is set when the slot is drained
+    uint8_t payload[TX_RING_PAYLOAD_MAX];
+} tx_ring_slot;
+
+/* A bounded multi-producer single-consumer queue of transfers waiting to be pushed to a
+ * Libcanard instance (D. Vyukov's bounded queue with a single consumer).
+ * Any number of threads may call tx_ring_push() concurrently without taking a lock, so a
+ * producer that is preempted cannot hold the others up; only the thread that owns the
+ * Libcanard instance calls tx_ring_drain(), which pushes the transfers to the TX queue,
+ * where they are ordered by priority.
+ * The slots are provided by the application; the capacity shall be a power of two.
+ */
+typedef struct
+{
+    tx_ring_slot *slots;
+    size_t mask;  // capacity - 1
+
+    _Alignas(TX_RING_CACHE_LINE) atomic_size_t head;  // Next position to claim by a producer
+    _Alignas(TX_RING_CACHE_LINE) size_t tail;         // Next position to drain; owned by the consumer
+
+    // Statistics, updated by the consumer
+    uint64_t transfers_drained;
+    uint64_t push_errors;  // Transfers rejected by canardTxPush(), e.g. out of memory
+} tx_ring;
+
+int tx_ring_init(tx_ring *r, tx_ring_slot *slots, size_t capacity);
+int tx_ring_push(tx_ring *r, const CanardTransfer *transfer);
+bool tx_ring_is_empty(const tx_ring *r);
+size_t tx_ring_drain(tx_ring *r, CanardInstance *ins);
+
+#endif  // TX_RING_H
@@ -1,4 +1,12 @@
 #!/bin/bash
+# Usage: ./scripts/startvcan.sh [device...]  (default: vcan0)
+# Pass several names, e.g. "vcan0 vcan1", to set up redundant buses.
+# The devices are created with the CAN FD MTU (72); set CLASSIC=1 to keep classic CAN.
 sudo modprobe vcan
-sudo ip link add dev vcan0 type vcan
-sudo ip link set up vcan0
\ No newline at end of file
+for dev in "${@:-vcan0}"; do
+    sudo ip link add dev "$dev" type vcan
+    if [ -z "$CLASSIC" ]; then
+        sudo ip link set "$dev" mtu 72
+    fi
+    sudo ip link set up "$dev"
+done
@@ -0,0 +1,61 @@
+#!/bin/bash
+# Usage: ./scripts/testvcan.sh [seconds]  (default: 5)
+# Runs the TX and RX nodes over two redundant virtual buses, vcan0 and vcan1, and checks that every
+# heartbeat sent on both buses is received exactly once. Build the nodes with `make` first.
+# The buses are created with ./scripts/startvcan.sh if they do not exist; set CLASSIC=1 for classic CAN.
+# The output of the nodes is line-buffered so that nothing is lost when they are stopped.
+# If candump (can-utils) is installed, the traffic of each bus is checked as well.
+cd "$(dirname "$0")/.." || exit 1
+SECONDS_TO_RUN="${1:-5}"
+IFACES="vcan0 vcan1"
+LOG_DIR="$(mktemp -d)"
+
+missing=""
+for dev in $IFACES; do
+    ip link show "$dev" > /dev/null 2>&1 || missing="$missing $dev"
+done
+if [ -n "$missing" ]; then
+    ./scripts/startvcan.sh $missing || exit 1
+fi
+
+DUMP_PIDS=""
+if command -v candump > /dev/null; then
+    for dev in $IFACES; do
+        candump -L "$dev" > "$LOG_DIR/$dev.log" &
+        DUMP_PIDS="$DUMP_PIDS $!"
+    done
+fi
+
+TERM=dumb stdbuf -oL ./bin/test_canard_rx $IFACES > "$LOG_DIR/rx.log" 2>&1 &
+RX_PID=$!
+sleep 0.5
+TERM=dumb timeout "$SECONDS_TO_RUN" stdbuf -oL ./bin/test_canard_tx $IFACES > "$LOG_DIR/tx.log" 2>&1
+sleep 0.5
+kill $RX_PID $DUMP_PIDS 2> /dev/null
+wait 2> /dev/null
+
+# The TX node prints the uptime of each heartbeat before submitting it, the RX node after receiving it.
+sent=$(grep -c '^Uptime:' "$LOG_DIR/tx.log")
+received=$(grep -c '^Uptime:' "$LOG_DIR/rx.log")
+unique=$(grep '^Uptime:' "$LOG_DIR/rx.log" | sort -u | wc -l)
+echo "Heartbeats sent: $sent, received: $received, distinct: $unique"
+
+status=0
+if [ "$sent" -eq 0 ] || [ "$received" -ne "$unique" ] || [ "$received" -lt $((sent - 1)) ]; then
+    # The last heartbeat may still be in flight when the TX node is stopped.
+    echo "FAIL: each heartbeat shall be received exactly once"
+    status=1
+fi
+if [ -n "$DUMP_PIDS" ]; then
+    for dev in $IFACES; do
+        frames=$(wc -l < "$LOG_DIR/$dev.log")
+        echo "Frames on $dev: $frames"
+        if [ "$frames" -eq 0 ]; then
+            echo "FAIL: nothing was sent on $dev"
+            status=1
+        fi
+    done
+fi
+[ $status -eq 0 ] && echo "PASS"
+echo "Logs: $LOG_DIR"
+exit $status
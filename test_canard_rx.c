@@ -7,13 +7,16 @@
  * Description:
  *
  * Receives an UAVCAN Heartbeat message over a virtual SocketCAN bus.
+ * Pass several interface names to receive over redundant buses, e.g.
+ * ./bin/test_canard_rx vcan0 vcan1 (default: vcan0).
  *
  */
 
 // UAVCAN specific includes
 #include "uavcan/node/Heartbeat_1_0.h"
 #include "libcanard/canard.h"
-#include "o1heap/o1heap.h"
+#include "o1heap/o1heap_arena.h"
+#include "o1heap/o1heap_pool.h"
 #include "socketcan/socketcan.h"
 
 // Linux specific includes
@@ -31,26 +34,59 @@
 
 // Defines
 #define O1HEAP_MEM_SIZE 4096
+// When the heap runs out, another arena of this size is mapped; it is unmapped after staying empty for the cooldown
+#define O1HEAP_GROWTH_SIZE 16384
+#define O1HEAP_COOLDOWN_USEC 5000000
+// Plain pages: the arenas are a few KiB, which a huge page would round up to 2 MiB each; see o1heap_arena.h
+// for the options that pay off with larger heaps
+#define O1HEAP_ARENA_FLAGS 0U
+// Remote nodes whose heartbeat sessions are served from the fixed-size pools; the rest go to the heap
+#define RX_POOL_REMOTE_NODES 16
 #define NODE_ID 97
 
 // Function prototypes for allocating memory to CanardInstance
 static void* memAllocate(CanardInstance* const ins, const size_t amount);
 static void memFree(CanardInstance* const ins, void* const pointer);
+static int update_acceptance_filters(void);
 
 // Create an o1heap and Canard instance
-O1HeapInstance* my_allocator;
+O1HeapArenaSet my_allocator;
+O1HeapPool my_pool;
 CanardInstance ins;
 
-// vcan0 socket descriptor
-int s;
+// Redundant CAN transport (vcan0 unless specified otherwise)
+socketcan_transport transport;
 
-int main(void) {
+int main(int argc, char *argv[]) {
 
-	void *mem_space = malloc(O1HEAP_MEM_SIZE);
-	// Initialization of o1heap allocator for libcanard, requires 16-byte alignment, view linker file
-	my_allocator = o1heapInit(mem_space, (size_t)O1HEAP_MEM_SIZE, NULL, NULL);
+	// Initialization of o1heap allocator for libcanard; the arenas are mapped from the OS, which aligns them
+	if(!o1heapArenaSetInit(&my_allocator, O1HEAP_MEM_SIZE, O1HEAP_GROWTH_SIZE, O1HEAP_COOLDOWN_USEC, O1HEAP_ARENA_FLAGS))
+	{
+		perror("Heap init");
+		return -1;
+	}
+
+	// Every heartbeat publisher costs one session and one payload buffer. o1heap would round each of them up
+	// to a power of two with its own overhead, so they are served from pools of the exact sizes instead.
+	// The pool sizes shall be ascending; the payload buffer of a Heartbeat is the smaller one.
+	const size_t pool_block_sizes[] = {
+		canardRxGetPayloadBufferSize(uavcan_node_Heartbeat_1_0_EXTENT_BYTES_),
+		canardRxGetSessionSize(),
+	};
+	const size_t pool_block_counts[] = { RX_POOL_REMOTE_NODES, RX_POOL_REMOTE_NODES };
+	const size_t pool_storage_size = o1heapPoolGetStorageSize(pool_block_sizes, pool_block_counts, 2);
+	void *pool_storage = malloc(pool_storage_size);
+	if(!o1heapPoolInit(&my_pool, pool_storage, pool_storage_size, pool_block_sizes, pool_block_counts, 2, NULL))
+	{
+		fprintf(stderr, "Pool init failed\n");
+		return -1;
+	}
 
-	int sock_ret = open_can_socket(&s);
+	// Open every interface given on the command line; each one is a redundant transport.
+	static const char *const default_ifnames[] = { "vcan0" };
+	const char *const *ifnames = (argc > 1) ? (const char *const *)&argv[1] : default_ifnames;
+	const size_t iface_count = (argc > 1) ? (size_t)(argc - 1) : 1;
+	int sock_ret = socketcan_transport_open(&transport, ifnames, iface_count);
 
 	if(sock_ret < 0)
 	{
@@ -72,10 +108,20 @@ int main(void) {
 							 uavcan_node_Heartbeat_1_0_EXTENT_BYTES_,
 							 CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
 							 &heartbeat_subscription);
+
+	// Let the kernel drop the frames we are not subscribed to. Call this again after every
+	// change of the subscriptions or the node-ID.
+	if(update_acceptance_filters() < 0)
+	{
+		printf("Fatal error setting CAN filters. Exiting.\n");
+		return -1;
+	}
 							 
 	// SocketCAN specifics
     int nbytes;
-    struct can_frame socketcan_frame;
+    struct canfd_frame socketcan_frames[SOCKETCAN_BATCH_MAX];
+    uint8_t iface_indices[SOCKETCAN_BATCH_MAX];
+    uint64_t timestamps_usec[SOCKETCAN_BATCH_MAX];
 
     // CanardFrame for reception
     CanardFrame received_canard_frame;
@@ -83,76 +129,126 @@ int main(void) {
 	// Block waiting for reception interrupts to happen
 	for(;;)
 	{
-	    // Read from CAN bus (this is a blocking call!)
-		if(recv_can_data(&s, &socketcan_frame))
+	    // Read as many frames as are queued on the CAN buses with one system call per bus (this is a blocking call!)
+		const int frame_count = socketcan_transport_recv_batch(&transport, socketcan_frames, iface_indices,
+															   timestamps_usec, SOCKETCAN_BATCH_MAX, -1);
+		if(frame_count < 0)
 		{
 			printf("Fatal error receiving CAN data. Exiting.\n");
 			return -1;
 		}
 
-		// Transfer all of the data from the CAN frame to a canard frame
-		received_canard_frame.extended_can_id = socketcan_frame.can_id;
-		received_canard_frame.payload_size = CanardCANDLCToLength[socketcan_frame.can_dlc];
-		received_canard_frame.timestamp_usec = time(NULL);
-		received_canard_frame.payload = socketcan_frame.data;
-
-		// Create a CanardTransfer and accept the data
-		CanardTransfer transfer;
-		const int8_t res1 = canardRxAccept(&ins,
-											 &received_canard_frame,
-											 0,
-											 &transfer);
-		
-		// If for some reason Libcanard doesn't like that frame, break from the loop	
-		if(res1 < 0)
+		for(int k = 0; k < frame_count; k++)
 		{
-		    printf("Fatal error, exiting\n"); 
-		    break; 
-		} // Error occurred
+			const struct canfd_frame* const socketcan_frame = &socketcan_frames[k];
+			const uint8_t iface_index = iface_indices[k];
+
+			// Only extended data frames can carry UAVCAN transfers; skip everything else.
+			if(!(socketcan_frame->can_id & CAN_EFF_FLAG) || (socketcan_frame->can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG)))
+			{
+				continue;
+			}
+
+			// Transfer all of the data from the CAN frame to a canard frame.
+			// SocketCAN reports the payload length (not the DLC) for both classic and FD frames.
+			received_canard_frame.extended_can_id = socketcan_frame->can_id & CAN_EFF_MASK;
+			received_canard_frame.payload_size = socketcan_frame->len;
+			// The kernel receive timestamp (monotonic, microseconds) drives the transfer-ID timeout.
+			received_canard_frame.timestamp_usec = timestamps_usec[k];
+			received_canard_frame.payload = socketcan_frame->data;
+
+			// Create a CanardTransfer and accept the data
+			CanardTransfer transfer;
+			// The interface index tells Libcanard which redundant transport the frame came from,
+			// so that it can deduplicate transfers received over more than one bus.
+			const int8_t res1 = canardRxAccept(&ins,
+												 &received_canard_frame,
+												 iface_index,
+												 &transfer);
+		
+			// If for some reason Libcanard doesn't like that frame, exit	
+			if(res1 < 0)
+			{
+			    printf("Fatal error, exiting\n"); 
+			    return -1; 
+			} // Error occurred
 
-		else if(res1 == 1) // A transfer was completed
-		{
-			// Instantiate a heartbeat message
-			uavcan_node_Heartbeat_1_0 RX_hbeat;
-			size_t hbeat_ser_buf_size = uavcan_node_Heartbeat_1_0_EXTENT_BYTES_;
+			else if(res1 == 1) // A transfer was completed
+			{
+				// Instantiate a heartbeat message
+				uavcan_node_Heartbeat_1_0 RX_hbeat;
+				size_t hbeat_ser_buf_size = uavcan_node_Heartbeat_1_0_EXTENT_BYTES_;
 
-			// De-serialize the heartbeat message
-			int8_t res2 = uavcan_node_Heartbeat_1_0_deserialize_(&RX_hbeat, transfer.payload, &hbeat_ser_buf_size);
+				// De-serialize the heartbeat message
+				int8_t res2 = uavcan_node_Heartbeat_1_0_deserialize_(&RX_hbeat, transfer.payload, &hbeat_ser_buf_size);
 
-			if(res2 < 0)
-			{  
-				printf("Error occurred deserializing data. Exiting...\n");
-				break;
-			} // Error occurred
+				if(res2 < 0)
+				{  
+					printf("Error occurred deserializing data. Exiting...\n");
+					return -1;
+				} // Error occurred
 			
-            system("clear");
-			printf("Uptime: %d\n", RX_hbeat.uptime);
-			printf("Health: %d\n", RX_hbeat.health);
-			printf("Mode: %d\n\n", RX_hbeat.mode);
-
-			// Deallocation of memory
-			ins.memory_free(&ins, (void*)transfer.payload);
-
-		}
-		else
-		{
-			// The received frame is not the last from a multi-frame transfer
+	            system("clear");
+				printf("Uptime: %d\n", RX_hbeat.uptime);
+				printf("Health: %d\n", RX_hbeat.health);
+				printf("Mode: %d\n\n", RX_hbeat.mode);
+
+				// Return the payload buffer to the library so that the next transfer reuses it
+				canardRxReleasePayload(&ins, &transfer);
+
+			}
+			else
+			{
+				// The received frame is not the last from a multi-frame transfer
+			}
 		}
 	}
 
 	return 0;
 }
 
+/* Build the CAN acceptance filters from the active subscriptions and install them on every interface. */
+static int update_acceptance_filters(void)
+{
+	CanardFilter canard_filters[SOCKETCAN_MAX_FILTERS];
+	const int32_t count = canardRxMakeFilters(&ins, canard_filters, SOCKETCAN_MAX_FILTERS);
+	if(count < 0)
+	{
+		return -1;
+	}
+
+	// Match extended data frames only; RTR frames never carry UAVCAN transfers.
+	struct can_filter filters[SOCKETCAN_MAX_FILTERS];
+	for(int32_t i = 0; i < count; i++)
+	{
+		filters[i].can_id = canard_filters[i].extended_can_id | CAN_EFF_FLAG;
+		filters[i].can_mask = canard_filters[i].extended_mask | CAN_EFF_FLAG | CAN_RTR_FLAG;
+	}
+	return socketcan_transport_set_filters(&transport, filters, (size_t)count);
+}
+
 static void* memAllocate(CanardInstance* const ins, const size_t amount)
 {
     (void) ins;
-    return o1heapAllocate(my_allocator, amount);
+    void* out = o1heapPoolAllocate(&my_pool, amount);
+    if (out == NULL)
+    {
+        out = o1heapArenaSetAllocate(&my_allocator, amount);
+    }
+    return out;
 }
 
 static void memFree(CanardInstance* const ins, void* const pointer)
 {
     (void) ins;
-    o1heapFree(my_allocator, pointer); 
+    if (o1heapPoolOwns(&my_pool, pointer))
+    {
+        o1heapPoolFree(&my_pool, pointer);
+    }
+    else
+    {
+        o1heapArenaSetFree(&my_allocator, pointer);
+    }
 }
 
 
@@ -7,6 +7,8 @@
  * Description:
  *
  * Transmits an UAVCAN Heartbeat message over a virtual SocketCAN bus.
+ * Pass several interface names to transmit over redundant buses, e.g.
+ * ./bin/test_canard_tx vcan0 vcan1 (default: vcan0).
  *
  */
 
@@ -14,7 +16,10 @@
 #include <uavcan/node/Heartbeat_1_0.h>
 #include <libcanard/canard.h>
 #include <o1heap/o1heap.h>
+#include <o1heap/o1heap_arena.h>
+#include <o1heap/o1heap_cache.h>
 #include <socketcan/socketcan.h>
+#include <socketcan/tx_pump.h>
 
 // Linux specific includes
 #include <time.h>
@@ -32,18 +37,33 @@
 
 // Defines
 #define O1HEAP_MEM_SIZE 4096
+// Plain pages: a 4 KiB heap fits in one, a huge page would map 2 MiB for it; see o1heap_arena.h
+// for the options that pay off with larger heaps
+#define O1HEAP_ARENA_FLAGS 0U
 #define NODE_ID 96
 #define UPTIME_SEC_MAX 31
-#define TX_PROC_SLEEP_TIME 5000
+#define TX_DEADLINE_USEC 1000000
+#define TX_RING_CAPACITY 16
+// Log the heap state after every failed allocation; build with e.g. -DHEAP_SAMPLE_PERIOD=64 to log it
+// after every 64th allocation attempt as well
+#ifndef HEAP_SAMPLE_PERIOD
+#define HEAP_SAMPLE_PERIOD 0
+#endif
+#define USE_CANFD_BRS 1
 
 // Function prototypes
 void *process_canard_TX_stack(void* arg);
 static void* memAllocate(CanardInstance* const ins, const size_t amount);
 static void memFree(CanardInstance* const ins, void* const pointer);
+static void heapLock(void);
+static void heapUnlock(void);
+static void heapSample(O1HeapInstance* const handle, void* const user_reference);
 
 // Create an o1heap and Canard instance
 O1HeapInstance* my_allocator;
-volatile CanardInstance ins;
+// The instance is shared with the TX thread; access it through the pump (tx_pump_push(), tx_pump_lock()).
+CanardInstance ins;
+pthread_mutex_t heap_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // Transfer ID
 static uint8_t my_message_transfer_id = 0;
@@ -55,18 +75,35 @@ uint32_t test_uptimeSec = 0;
 size_t hbeat_ser_buf_size = uavcan_node_Heartbeat_1_0_EXTENT_BYTES_;
 uint8_t hbeat_ser_buf[uavcan_node_Heartbeat_1_0_EXTENT_BYTES_];
 
-// vcan0 socket descriptor
-int s;
+// Redundant CAN transport (vcan0 unless specified otherwise)
+socketcan_transport transport;
 
-int main(void)
+// Moves the frames from the Libcanard TX queue to the transport
+tx_pump pump;
+
+// Transfers submitted to the TX thread without locking the instance
+tx_ring ring;
+tx_ring_slot ring_slots[TX_RING_CAPACITY];
+
+int main(int argc, char *argv[])
 {
-	// Allocate 4KB of memory for o1heap.
-    void *mem_space = malloc(O1HEAP_MEM_SIZE);
-    
-    // Initialize o1heap
-    my_allocator = o1heapInit(mem_space, (size_t)O1HEAP_MEM_SIZE, NULL, NULL);
+    // Map at least 4KB of memory for o1heap; the mapping is page-aligned, which satisfies O1HEAP_ALIGNMENT.
+    O1HeapArenaRegion mem_space;
+    if(!o1heapArenaMap(O1HEAP_MEM_SIZE, O1HEAP_ARENA_FLAGS, &mem_space))
+    {
+        perror("Heap map");
+        return -1;
+    }
+
+    // Initialize o1heap. It is used from both threads, so it needs critical section hooks.
+    my_allocator = o1heapInit(mem_space.base, mem_space.size, &heapLock, &heapUnlock);
+    o1heapSetSamplingHook(my_allocator, HEAP_SAMPLE_PERIOD, &heapSample, NULL);
     
-    int sock_ret = open_can_socket(&s);
+    // Open every interface given on the command line; each frame is sent on all of them.
+    static const char *const default_ifnames[] = { "vcan0" };
+    const char *const *ifnames = (argc > 1) ? (const char *const *)&argv[1] : default_ifnames;
+    const size_t iface_count = (argc > 1) ? (size_t)(argc - 1) : 1;
+    int sock_ret = socketcan_transport_open(&transport, ifnames, iface_count);
 
     // Make sure our socket opens successfully.
     if(sock_ret < 0)
@@ -75,15 +112,23 @@ int main(void)
         return -1;
     }
     
-    // Initialize canard as CANFD and node no. 96
+    // Initialize canard as node no. 96. Use CAN FD frames (64 bytes) if every interface supports them,
+    // classic frames (8 bytes) otherwise.
     ins = canardInit(&memAllocate, &memFree);
-    ins.mtu_bytes = CANARD_MTU_CAN_FD;
+    ins.mtu_bytes = socketcan_transport_payload_mtu(&transport);
     ins.node_id = NODE_ID;
+    socketcan_transport_set_brs(&transport, USE_CANFD_BRS);
 
-    // Initialize thread for processing TX queue
+    // Initialize thread for processing TX queue. It sleeps until we push a transfer.
+    if(tx_pump_init(&pump, &ins, &transport) < 0)
+    {
+        socketcan_transport_close(&transport);
+        return -1;
+    }
+    tx_ring_init(&ring, ring_slots, TX_RING_CAPACITY);
+    tx_pump_set_ring(&pump, &ring);
     pthread_t thread_id;
-    int exit_thread = 0;
-    pthread_create(&thread_id, NULL, &process_canard_TX_stack, (void*)&exit_thread);
+    pthread_create(&thread_id, NULL, &process_canard_TX_stack, (void*)&pump);
     
     // Main control loop. Run until break condition is found.
     for(;;)
@@ -117,7 +162,7 @@ int main(void)
         
         // Create a CanardTransfer and give it the required data.
         const CanardTransfer transfer = {
-            .timestamp_usec = time(NULL),
+            .timestamp_usec = socketcan_monotonic_usec() + TX_DEADLINE_USEC,  // Drop if not sent within 1 s
             .priority = CanardPriorityNominal,
             .transfer_kind = CanardTransferKindMessage,
             .port_id = uavcan_node_Heartbeat_1_0_FIXED_PORT_ID_,
@@ -135,101 +180,94 @@ int main(void)
         if(test_uptimeSec > UPTIME_SEC_MAX)
         {
             printf("Reached 30s uptime! Exiting...\n");
-            exit_thread = 1;
             break;
         }
         
-        // Push our CanardTransfer to the Libcanard instance's transfer stack.
-        int32_t result2 = canardTxPush((CanardInstance* const)&ins, &transfer);
+        // Hand our CanardTransfer over to the TX thread, which pushes it to the Libcanard instance's
+        // transfer stack and sends the frames right away. Any thread may do this without a lock.
+        int result2 = tx_pump_submit(&pump, &transfer);
         
         // Make sure our push onto the stack was successful.
         if(result2 < 0)
         {
-            printf("Pushing onto TX stack failed. Aborting...\n");
+            printf("Submitting to the TX thread failed. Aborting...\n");
             break;
         }
     }
 
-    // Main control loop exited. Wait for our spawned process thread to exit and then free our allocated memory space for o1heap.
+    // Main control loop exited. Let the TX thread send what is left and wait for it to exit,
+    // then free our allocated memory space for o1heap.
+    tx_pump_stop(&pump);
     pthread_join(thread_id, NULL);
-    free(mem_space);
+    tx_pump_close(&pump);
+    socketcan_transport_close(&transport);
+    o1heapArenaUnmap(&mem_space);
     return 0;
 }
 
-/* Standard memAllocate and memFree from o1heap examples. */
+/* memAllocate and memFree from o1heap examples, going through the per-thread cache so that
+ * the threads sharing the heap rarely need to take its lock. */
 static void* memAllocate(CanardInstance* const ins, const size_t amount)
 {
     (void) ins;
-    return o1heapAllocate(my_allocator, amount);
+    return o1heapCacheAllocate(my_allocator, amount);
 }
 
 static void memFree(CanardInstance* const ins, void* const pointer)
 {
     (void) ins;
-    o1heapFree(my_allocator, pointer);
+    o1heapCacheFree(my_allocator, pointer);
 }
 
-/* Function to process the Libcanard TX stack, package into a SocketCAN frame, and send on the bus. */
-void *process_canard_TX_stack(void* arg)
+/* Critical section hooks for o1heap. */
+static void heapLock(void)
 {
-    printf("Entered thread.\n");
-    for(;;)
-    {
-        // Run every 5ms to prevent using too much CPU.
-        usleep(TX_PROC_SLEEP_TIME);
-
-        // Check to see if main thread has asked this thread to stop.
-        int* exit_thread = (int*)arg;
+    pthread_mutex_lock(&heap_mutex);
+}
 
-        // Check to make sure there's no frames in the transfer stack, then check to see if this thread should exit.
-        // If so, exit the thread.
-        if(canardTxPeek((CanardInstance* const)&ins) == NULL && *exit_thread)
-        {
-            printf("Exiting thread.\n");
-            return;
-        }
+static void heapUnlock(void)
+{
+    pthread_mutex_unlock(&heap_mutex);
+}
 
-        // Loop through all of the frames in the transfer stack.
-        for(const CanardFrame* txf = NULL; (txf = canardTxPeek((CanardInstance* const)&ins)) != NULL;)
+/* Sampling hook for o1heap, invoked outside of the critical section. If an allocation fails while much more
+ * memory is free than the largest allocation, the heap is fragmented rather than exhausted.
+ * The bytes used include the fragments cached by the threads (see o1heap_cache.h). */
+static void heapSample(O1HeapInstance* const handle, void* const user_reference)
+{
+    (void) user_reference;
+    O1HeapExtendedDiagnostics diag;
+    o1heapGetExtendedDiagnostics(handle, &diag);
+    fprintf(stderr, "heap: %zu/%zu bytes used, largest allocation %zu, %lu OOM; free fragments per bin:",
+            diag.basic.allocated, diag.basic.capacity, diag.largest_allocation,
+            (unsigned long)diag.basic.oom_count);
+    for(size_t i = 0; i < O1HEAP_BIN_COUNT; i++)
+    {
+        if(diag.free_fragments[i] > 0)
         {
-            // Make sure we aren't sending a message before the actual time.
-            if(txf->timestamp_usec < (unsigned long)time(NULL))
-            {
-                // Instantiate a SocketCAN CAN frame.
-                struct can_frame frame;
-
-                // Give payload size.
-                // Libcanard states that payload_size != can_dlc. Use provided
-                // lookup table to correctly populate frame.can_dlc
-                frame.can_dlc = CanardCANLengthToDLC[txf->payload_size];
-                
-                // Give extended can id.
-                // Make sure to use CAN_EFF_FLAG or you won't get extended CAN ID.
-                frame.can_id = txf->extended_can_id | CAN_EFF_FLAG;
-                
-                // Copy transfer payload to SocketCAN frame.
-                memcpy(&frame.data[0], txf->payload, txf->payload_size);
-                
-                // Print RAW can data.
-                printf("0x%03X [%d] ",frame.can_id, frame.can_dlc);
-                for (uint8_t i = 0; i < frame.can_dlc; i++)
-                        printf("%02X ",frame.data[i]);
-                printf(" Sent!\n\n");
-                    
-                // Send CAN Frame.
-                if(send_can_data(&s, &frame) < 0)
-                {
-                    printf("Fatal error sending CAN data. Exiting thread.\n");
-                    return;
-                }
-
-                // Pop the sent data off the stack and free its memory.
-                canardTxPop((CanardInstance* const)&ins);
-                ins.memory_free((CanardInstance* const)&ins, (CanardFrame*)txf);
-            }
+            fprintf(stderr, " %zu*%zu", diag.free_fragments[i], (size_t)(2U * O1HEAP_ALIGNMENT) << i);
         }
     }
+    fprintf(stderr, "\n");
 }
 
+/* Function to process the Libcanard TX stack, package into SocketCAN frames, and send them on the bus.
+ * Instead of polling, the pump blocks until a transfer is pushed or a full interface can take more frames. */
+void *process_canard_TX_stack(void* arg)
+{
+    tx_pump* p = (tx_pump*)arg;
+    printf("Entered thread.\n");
+    const int result = tx_pump_run(p);
 
-
+    // Give the heap fragments cached by this thread back before it exits.
+    o1heapCacheFlush();
+    if(result < 0)
+    {
+        printf("Fatal error sending CAN data. Exiting thread.\n");
+        return NULL;
+    }
+    printf("Exiting thread. Sent %lu frames (%lu expired, %lu overrun, %lu send errors) in %lu wakeups.\n",
+           (unsigned long)p->frames_staged, (unsigned long)p->frames_expired, (unsigned long)p->frames_overrun,
+           (unsigned long)p->send_errors, (unsigned long)p->wakeups);
+    return NULL;
+}
@@ -0,0 +1,351 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Measures the hot paths of Libcanard that the TX and RX nodes depend on.
+ * Each section prints the mean time per operation; run it with `make bench`.
+ * The sections to run may be listed on the command line (tx, crc, lookup, batch); all of them run by default.
+ * Build with CANARD_CONFIG_EXPOSE_PRIVATE=1, which makes the CRC routine reachable.
+ *
+ */
+
+#include <libcanard/canard.h>
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Defines
+#define TX_QUEUE_DEPTH_MIN 10
+#define TX_QUEUE_DEPTH_MAX 10000
+#define TX_ITERATIONS 262144
+// Pushes and pops timed together, also the amount by which the queue depth oscillates
+#define TX_BURST 32
+#define CRC_SIZE_MAX 65536
+// Hashed at each size, so that the large sizes take as long as the small ones
+#define CRC_BYTES_PER_SIZE (16UL * 1024UL * 1024UL)
+#define RX_SUBSCRIPTIONS_MAX 1024
+#define RX_ITERATIONS 262144
+#define RX_BURST 32
+#define RX_REMOTE_NODE_ID 10
+#define RX_BATCH_SUBSCRIPTIONS 8
+
+// The CRC implementation selected for canard.c; 0 is its default, CANARD_CRC_BITWISE
+#ifndef CANARD_CONFIG_CRC
+#define CANARD_CONFIG_CRC 0
+#endif
+
+// Private to canard.c, exported by CANARD_CONFIG_EXPOSE_PRIVATE
+uint16_t crcAdd(const uint16_t crc, const size_t size, const void* const data);
+
+// Function prototypes
+static void* memAllocate(CanardInstance* const ins, const size_t amount);
+static void memFree(CanardInstance* const ins, void* const pointer);
+static uint64_t nowNsec(void);
+static uint32_t nextRandom(void);
+static bool sectionEnabled(const int argc, char* const argv[], const char* const name);
+static void benchTxPushPop(const size_t depth);
+static void benchCrc(const size_t size);
+static uint32_t makeMessageCANID(const CanardPortID subject_id, const CanardNodeID source_node_id);
+static void benchRxLookup(const size_t subscription_count, const bool indexed);
+static void benchRxBatch(const bool batched);
+
+// Keeps the compiler from discarding the results of the measured code
+volatile uint64_t bench_sink;
+
+static uint32_t random_state = 12345U;
+
+static const char *const crc_names[] = { "bitwise", "table", "slicing-by-8" };
+
+// Large, so kept out of the stack
+static CanardRxSubscription subscriptions[RX_SUBSCRIPTIONS_MAX];
+static CanardRxSubscription* message_index[CANARD_SUBJECT_ID_MAX + 1U];
+
+int main(int argc, char *argv[])
+{
+    if(sectionEnabled(argc, argv, "tx"))
+    {
+        printf("TX push/pop, single-frame transfers of random priority:\n");
+        for(size_t depth = TX_QUEUE_DEPTH_MIN; depth <= TX_QUEUE_DEPTH_MAX; depth *= 10)
+        {
+            benchTxPushPop(depth);
+        }
+    }
+    if(sectionEnabled(argc, argv, "crc"))
+    {
+        printf("Transfer CRC, %s:\n", crc_names[CANARD_CONFIG_CRC]);
+        for(size_t size = 16; size <= CRC_SIZE_MAX; size *= 4)
+        {
+            benchCrc(size);
+        }
+    }
+    if(sectionEnabled(argc, argv, "lookup"))
+    {
+        printf("RX single-frame transfers, linear subscription search vs canardRxSetIndex():\n");
+        for(size_t count = 1; count <= RX_SUBSCRIPTIONS_MAX; count *= 8)
+        {
+            benchRxLookup(count, false);
+            benchRxLookup(count, true);
+        }
+    }
+    if(sectionEnabled(argc, argv, "batch"))
+    {
+        printf("RX single-frame transfers, canardRxAccept() loop vs canardRxAcceptBatch():\n");
+        benchRxBatch(false);
+        benchRxBatch(true);
+    }
+    return 0;
+}
+
+static bool sectionEnabled(const int argc, char* const argv[], const char* const name)
+{
+    bool out = argc < 2;
+    for(int i = 1; i < argc; i++)
+    {
+        out = out || (strcmp(argv[i], name) == 0);
+    }
+    return out;
+}
+
+static void* memAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return malloc(amount);
+}
+
+static void memFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    free(pointer);
+}
+
+static uint64_t nowNsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* xorshift32; deterministic so that the runs are comparable. */
+static uint32_t nextRandom(void)
+{
+    random_state ^= random_state << 13U;
+    random_state ^= random_state >> 17U;
+    random_state ^= random_state << 5U;
+    return random_state;
+}
+
+/* Keeps the queue near the given depth while pushing new transfers and popping the head, which is the steady state
+ * of a node whose bus is busy. The queue index makes the cost grow with the logarithm of the depth.
+ * The operations are timed in bursts so that reading the clock does not dominate the result. */
+static void benchTxPushPop(const size_t depth)
+{
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    uint8_t payload[7] = {0};
+    CanardTransfer transfer = {
+        .timestamp_usec = 0,
+        .transfer_kind = CanardTransferKindMessage,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .payload_size = sizeof(payload),
+        .payload = payload,
+    };
+    for(size_t i = 0; i < depth; i++)
+    {
+        transfer.priority = (CanardPriority)(nextRandom() % (CANARD_PRIORITY_MAX + 1U));
+        transfer.port_id = (CanardPortID)(nextRandom() % (CANARD_SUBJECT_ID_MAX + 1U));
+        (void) canardTxPush(&ins, &transfer);
+    }
+
+    const CanardFrame* popped[TX_BURST];
+    uint64_t push_nsec = 0;
+    uint64_t pop_nsec = 0;
+    for(size_t i = 0; i < TX_ITERATIONS; i += TX_BURST)
+    {
+        const uint64_t t0 = nowNsec();
+        for(size_t k = 0; k < TX_BURST; k++)
+        {
+            transfer.priority = (CanardPriority)(nextRandom() % (CANARD_PRIORITY_MAX + 1U));
+            transfer.port_id = (CanardPortID)(nextRandom() % (CANARD_SUBJECT_ID_MAX + 1U));
+            transfer.transfer_id = (CanardTransferID)k;
+            (void) canardTxPush(&ins, &transfer);
+        }
+        const uint64_t t1 = nowNsec();
+        for(size_t k = 0; k < TX_BURST; k++)
+        {
+            popped[k] = canardTxPeek(&ins);
+            canardTxPop(&ins);
+        }
+        const uint64_t t2 = nowNsec();
+        for(size_t k = 0; k < TX_BURST; k++)
+        {
+            bench_sink += popped[k]->extended_can_id;
+            canardTxFree(&ins, popped[k]);
+        }
+        push_nsec += t1 - t0;
+        pop_nsec += t2 - t1;
+    }
+
+    for(const CanardFrame* frame = canardTxPeek(&ins); frame != NULL; frame = canardTxPeek(&ins))
+    {
+        canardTxPop(&ins);
+        canardTxFree(&ins, frame);
+    }
+    printf("  depth %5zu: push %6.1f ns, peek+pop %6.1f ns\n", depth,
+           (double)push_nsec / TX_ITERATIONS, (double)pop_nsec / TX_ITERATIONS);
+}
+
+/* The CRC covers the payload of every multi-frame transfer on both ends, once per byte. */
+static void benchCrc(const size_t size)
+{
+    static uint8_t data[CRC_SIZE_MAX];
+    for(size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)nextRandom();
+    }
+    const size_t iterations = CRC_BYTES_PER_SIZE / size;
+    uint16_t crc = 0xFFFFU;
+    const uint64_t t0 = nowNsec();
+    for(size_t i = 0; i < iterations; i++)
+    {
+        crc = crcAdd(crc, size, data);
+    }
+    const uint64_t t1 = nowNsec();
+    bench_sink += crc;
+    printf("  %5zu bytes: %9.1f ns, %5.2f ns/byte\n", size, (double)(t1 - t0) / (double)iterations,
+           (double)(t1 - t0) / ((double)iterations * (double)size));
+}
+
+static uint32_t makeMessageCANID(const CanardPortID subject_id, const CanardNodeID source_node_id)
+{
+    // Nominal priority, the two reserved bits set, as in canardTxPush().
+    return (4UL << 26U) | (3UL << 21U) | ((uint32_t)subject_id << 8U) | source_node_id;
+}
+
+/* Delivers single-frame messages on randomly chosen subscribed subjects. The subjects are spread over the whole range,
+ * so the linear search visits half of the subscriptions on average, while the index takes one look-up. */
+static void benchRxLookup(const size_t subscription_count, const bool indexed)
+{
+    static CanardTransferID transfer_ids[RX_SUBSCRIPTIONS_MAX];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    for(size_t i = 0; i < subscription_count; i++)
+    {
+        (void) canardRxSubscribe(&ins, CanardTransferKindMessage, (CanardPortID)(i * 7U), 8,
+                                 CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, &subscriptions[i]);
+        transfer_ids[i] = 0;
+    }
+    if(indexed)
+    {
+        (void) canardRxSetIndex(&ins, CanardTransferKindMessage, message_index,
+                                sizeof(message_index) / sizeof(message_index[0]));
+    }
+
+    static uint8_t payloads[RX_BURST][8];
+    CanardFrame frames[RX_BURST];
+    CanardTransfer transfers[RX_BURST];
+    int8_t results[RX_BURST];
+    uint64_t nsec = 0;
+    for(size_t i = 0; i < RX_ITERATIONS; i += RX_BURST)
+    {
+        for(size_t b = 0; b < RX_BURST; b++)
+        {
+            const size_t k = nextRandom() % subscription_count;
+            payloads[b][7] = (uint8_t)(0xE0U | (transfer_ids[k]++ & CANARD_TRANSFER_ID_MAX));  // Start, end, toggle
+            frames[b] = (CanardFrame){
+                .timestamp_usec = i + b,
+                .extended_can_id = makeMessageCANID((CanardPortID)(k * 7U), RX_REMOTE_NODE_ID),
+                .payload_size = sizeof(payloads[b]),
+                .payload = payloads[b],
+            };
+        }
+        const uint64_t t0 = nowNsec();
+        for(size_t b = 0; b < RX_BURST; b++)
+        {
+            results[b] = canardRxAccept(&ins, &frames[b], 0, &transfers[b]);
+        }
+        nsec += nowNsec() - t0;
+        for(size_t b = 0; b < RX_BURST; b++)
+        {
+            if(results[b] > 0)
+            {
+                canardRxReleasePayload(&ins, &transfers[b]);
+                bench_sink++;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < subscription_count; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, (CanardPortID)(i * 7U));
+    }
+    printf("  %4zu subscriptions, %s: %6.1f ns per frame\n", subscription_count, indexed ? "indexed" : "linear ",
+           (double)nsec / RX_ITERATIONS);
+}
+
+/* Delivers bursts of single-frame messages from several nodes on a few subjects, either frame by frame or as one
+ * batch, which is how the RX node drains its socket. */
+static void benchRxBatch(const bool batched)
+{
+    static CanardTransferID transfer_ids[RX_BATCH_SUBSCRIPTIONS][CANARD_NODE_ID_MAX + 1U];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    for(size_t i = 0; i < RX_BATCH_SUBSCRIPTIONS; i++)
+    {
+        (void) canardRxSubscribe(&ins, CanardTransferKindMessage, (CanardPortID)(i * 7U), 8,
+                                 CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, &subscriptions[i]);
+    }
+    memset(transfer_ids, 0, sizeof(transfer_ids));
+
+    static uint8_t payloads[RX_BURST][8];
+    CanardFrame frames[RX_BURST];
+    CanardTransfer transfers[RX_BURST];
+    size_t accepted = 0;
+    uint64_t nsec = 0;
+    for(size_t i = 0; i < RX_ITERATIONS; i += RX_BURST)
+    {
+        for(size_t b = 0; b < RX_BURST; b++)
+        {
+            const size_t k = nextRandom() % RX_BATCH_SUBSCRIPTIONS;
+            const CanardNodeID node_id = (CanardNodeID)(RX_REMOTE_NODE_ID + (nextRandom() % 4U));
+            payloads[b][7] = (uint8_t)(0xE0U | (transfer_ids[k][node_id]++ & CANARD_TRANSFER_ID_MAX));
+            frames[b] = (CanardFrame){
+                .timestamp_usec = i + b,
+                .extended_can_id = makeMessageCANID((CanardPortID)(k * 7U), node_id),
+                .payload_size = sizeof(payloads[b]),
+                .payload = payloads[b],
+            };
+        }
+        accepted = 0;
+        const uint64_t t0 = nowNsec();
+        if(batched)
+        {
+            // No pooled subscriptions, so the whole burst is processed in one call.
+            const int32_t result = canardRxAcceptBatch(&ins, frames, RX_BURST, 0, transfers, RX_BURST, NULL);
+            accepted = (result > 0) ? (size_t)result : 0U;
+        }
+        else
+        {
+            for(size_t b = 0; b < RX_BURST; b++)
+            {
+                accepted += (canardRxAccept(&ins, &frames[b], 0, &transfers[accepted]) > 0) ? 1U : 0U;
+            }
+        }
+        nsec += nowNsec() - t0;
+        for(size_t b = 0; b < accepted; b++)
+        {
+            canardRxReleasePayload(&ins, &transfers[b]);
+            bench_sink++;
+        }
+    }
+
+    for(size_t i = 0; i < RX_BATCH_SUBSCRIPTIONS; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, (CanardPortID)(i * 7U));
+    }
+    printf("  %s: %6.1f ns per frame\n", batched ? "batch" : "loop ", (double)nsec / RX_ITERATIONS);
+}
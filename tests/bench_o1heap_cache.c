@@ -0,0 +1,178 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Measures allocation and deallocation from 1 to 16 threads at once with three allocators: one o1heap shared
+ * through its critical section hooks (a mutex), the same heap behind the per-thread caches of o1heap_cache.h,
+ * and glibc malloc. Every thread keeps a window of live blocks of the sizes Libcanard asks for and replaces the
+ * oldest one in each step, like a node that receives and sends transfers. Run it with `make bench`.
+ *
+ */
+
+#include <o1heap/o1heap.h>
+#include <o1heap/o1heap_cache.h>
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Defines
+#define THREADS_MAX 16
+#define STEPS_PER_THREAD 200000
+// Blocks each thread holds at a time
+#define LIVE_BLOCKS 64
+#define HEAP_SIZE (16UL * 1024UL * 1024UL)
+
+typedef enum
+{
+    AllocatorLocked,
+    AllocatorCached,
+    AllocatorMalloc,
+} allocator_kind;
+
+// Function prototypes
+static uint64_t nowNsec(void);
+static void heapLock(void);
+static void heapUnlock(void);
+static void* allocate(const size_t amount);
+static void deallocate(void* const pointer);
+static void* runThread(void* arg);
+static void benchAllocator(const size_t thread_count, const allocator_kind kind);
+
+static const char* const allocator_names[] = { "o1heap, locked", "o1heap, cached", "glibc malloc  " };
+
+// Queue items, RX sessions and payload buffers of various sizes
+static const size_t block_sizes[] = { 24, 48, 72, 96, 136, 200, 264, 520 };
+
+static O1HeapInstance* heap;
+static pthread_mutex_t heap_mutex = PTHREAD_MUTEX_INITIALIZER;
+static allocator_kind kind_in_use;
+
+// Keeps the compiler from discarding the blocks
+volatile uint64_t bench_sink;
+
+int main(void)
+{
+    void* const arena = aligned_alloc(O1HEAP_ALIGNMENT, HEAP_SIZE);
+    if(arena == NULL)
+    {
+        return 1;
+    }
+    printf("Allocation and deallocation from concurrent threads, per pair:\n");
+    for(size_t count = 1; count <= THREADS_MAX; count *= 2)
+    {
+        for(int kind = AllocatorLocked; kind <= AllocatorMalloc; kind++)
+        {
+            // A fresh heap for each run, so that the runs do not inherit each other's fragmentation.
+            heap = o1heapInit(arena, HEAP_SIZE, &heapLock, &heapUnlock);
+            benchAllocator(count, (allocator_kind)kind);
+        }
+    }
+    free(arena);
+    return 0;
+}
+
+static uint64_t nowNsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void heapLock(void)
+{
+    pthread_mutex_lock(&heap_mutex);
+}
+
+static void heapUnlock(void)
+{
+    pthread_mutex_unlock(&heap_mutex);
+}
+
+static void* allocate(const size_t amount)
+{
+    void* out = NULL;
+    switch(kind_in_use)
+    {
+        case AllocatorLocked:
+            out = o1heapAllocate(heap, amount);
+            break;
+        case AllocatorCached:
+            out = o1heapCacheAllocate(heap, amount);
+            break;
+        default:
+            out = malloc(amount);
+            break;
+    }
+    return out;
+}
+
+static void deallocate(void* const pointer)
+{
+    switch(kind_in_use)
+    {
+        case AllocatorLocked:
+            o1heapFree(heap, pointer);
+            break;
+        case AllocatorCached:
+            o1heapCacheFree(heap, pointer);
+            break;
+        default:
+            free(pointer);
+            break;
+    }
+}
+
+/* Replaces the oldest live block with a new one of another size in every step. */
+static void* runThread(void* arg)
+{
+    uint32_t random_state = (uint32_t)(uintptr_t)arg * 2654435761U + 1U;
+    void* blocks[LIVE_BLOCKS] = {NULL};
+    for(size_t k = 0; k < STEPS_PER_THREAD; k++)
+    {
+        // xorshift32; deterministic so that the runs are comparable.
+        random_state ^= random_state << 13U;
+        random_state ^= random_state >> 17U;
+        random_state ^= random_state << 5U;
+        void** const slot = &blocks[k % LIVE_BLOCKS];
+        deallocate(*slot);
+        *slot = allocate(block_sizes[random_state % (sizeof(block_sizes) / sizeof(block_sizes[0]))]);
+        if(*slot != NULL)
+        {
+            *(volatile uint8_t*)*slot = (uint8_t)k;
+        }
+    }
+    for(size_t i = 0; i < LIVE_BLOCKS; i++)
+    {
+        bench_sink += (blocks[i] != NULL) ? 1U : 0U;
+        deallocate(blocks[i]);
+    }
+    if(kind_in_use == AllocatorCached)
+    {
+        o1heapCacheFlush();
+    }
+    return NULL;
+}
+
+static void benchAllocator(const size_t thread_count, const allocator_kind kind)
+{
+    kind_in_use = kind;
+    pthread_t threads[THREADS_MAX];
+    const uint64_t t0 = nowNsec();
+    for(size_t i = 0; i < thread_count; i++)
+    {
+        pthread_create(&threads[i], NULL, &runThread, (void*)(uintptr_t)i);
+    }
+    for(size_t i = 0; i < thread_count; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    const uint64_t nsec = nowNsec() - t0;
+    // Wall time over all pairs: with more threads than CPUs this is the throughput, not the latency.
+    printf("  %2zu threads, %s: %6.1f ns\n", thread_count, allocator_names[kind],
+           (double)nsec / (double)(thread_count * STEPS_PER_THREAD));
+}
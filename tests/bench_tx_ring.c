@@ -0,0 +1,188 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Measures the cost of submitting transfers to one Libcanard instance from 1 to 16 threads at once,
+ * with a mutex around canardTxPush() (as tx_pump_push() does) and through the lock-free ring (as
+ * tx_pump_submit() does). A consumer thread empties the TX queue meanwhile, in place of the pump.
+ * Each line prints the mean and the worst time of one submission; a producer that is preempted while
+ * holding the mutex shows up in the worst time of the others. Run it with `make bench`.
+ *
+ */
+
+#include <libcanard/canard.h>
+#include <socketcan/tx_ring.h>
+
+#include <time.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Defines
+#define PRODUCERS_MAX 16
+#define SUBMISSIONS_PER_PRODUCER 20000
+#define TX_RING_CAPACITY 256
+
+// Function prototypes
+static void* memAllocate(CanardInstance* const ins, const size_t amount);
+static void memFree(CanardInstance* const ins, void* const pointer);
+static uint64_t nowNsec(void);
+static void* runProducer(void* arg);
+static void* runConsumer(void* arg);
+static void benchSubmit(const size_t producer_count, const bool use_ring);
+
+typedef struct
+{
+    size_t id;
+    uint64_t total_nsec;
+    uint64_t max_nsec;
+} producer_result;
+
+static CanardInstance ins;
+static pthread_mutex_t ins_mutex = PTHREAD_MUTEX_INITIALIZER;
+static tx_ring ring;
+static tx_ring_slot ring_slots[TX_RING_CAPACITY];
+static bool ring_mode;
+static atomic_bool producers_done;
+
+// Keeps the compiler from discarding the frames taken off the queue
+volatile uint64_t bench_sink;
+
+int main(void)
+{
+    printf("Transfer submission from concurrent producers, mean/worst per submission:\n");
+    for(size_t count = 1; count <= PRODUCERS_MAX; count *= 2)
+    {
+        benchSubmit(count, false);
+        benchSubmit(count, true);
+    }
+    return 0;
+}
+
+static void* memAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return malloc(amount);
+}
+
+static void memFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    free(pointer);
+}
+
+static uint64_t nowNsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* Submits single-frame transfers, retrying while the ring is full; the retries count towards the time. */
+static void* runProducer(void* arg)
+{
+    producer_result* const result = (producer_result*)arg;
+    uint8_t payload[7] = {0};
+    CanardTransfer transfer = {
+        .timestamp_usec = 0,
+        .priority = CanardPriorityNominal,
+        .transfer_kind = CanardTransferKindMessage,
+        .port_id = (CanardPortID)result->id,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .payload_size = sizeof(payload),
+        .payload = payload,
+    };
+    for(size_t k = 0; k < SUBMISSIONS_PER_PRODUCER; k++)
+    {
+        transfer.transfer_id = (CanardTransferID)k;
+        const uint64_t t0 = nowNsec();
+        if(ring_mode)
+        {
+            while(tx_ring_push(&ring, &transfer) < 0)
+            {
+                sched_yield();
+            }
+        }
+        else
+        {
+            pthread_mutex_lock(&ins_mutex);
+            (void) canardTxPush(&ins, &transfer);
+            pthread_mutex_unlock(&ins_mutex);
+        }
+        const uint64_t nsec = nowNsec() - t0;
+        result->total_nsec += nsec;
+        result->max_nsec = (nsec > result->max_nsec) ? nsec : result->max_nsec;
+    }
+    return NULL;
+}
+
+/* Takes the frames off the queue until the producers are done and nothing is left, as the pump would. */
+static void* runConsumer(void* arg)
+{
+    (void) arg;
+    for(;;)
+    {
+        const bool done = atomic_load(&producers_done);
+        size_t popped = 0;
+        pthread_mutex_lock(&ins_mutex);
+        if(ring_mode)
+        {
+            (void) tx_ring_drain(&ring, &ins);
+        }
+        for(const CanardFrame* frame = canardTxPeek(&ins); frame != NULL; frame = canardTxPeek(&ins))
+        {
+            bench_sink += frame->extended_can_id;
+            canardTxPop(&ins);
+            canardTxFree(&ins, frame);
+            popped++;
+        }
+        pthread_mutex_unlock(&ins_mutex);
+        if(done && popped == 0 && (!ring_mode || tx_ring_is_empty(&ring)))
+        {
+            break;
+        }
+        if(popped == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void benchSubmit(const size_t producer_count, const bool use_ring)
+{
+    ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    tx_ring_init(&ring, ring_slots, TX_RING_CAPACITY);
+    ring_mode = use_ring;
+    atomic_store(&producers_done, false);
+
+    producer_result results[PRODUCERS_MAX];
+    pthread_t producers[PRODUCERS_MAX];
+    pthread_t consumer;
+    pthread_create(&consumer, NULL, &runConsumer, NULL);
+    for(size_t i = 0; i < producer_count; i++)
+    {
+        results[i] = (producer_result){ .id = i, .total_nsec = 0, .max_nsec = 0 };
+        pthread_create(&producers[i], NULL, &runProducer, &results[i]);
+    }
+    uint64_t total_nsec = 0;
+    uint64_t max_nsec = 0;
+    for(size_t i = 0; i < producer_count; i++)
+    {
+        pthread_join(producers[i], NULL);
+        total_nsec += results[i].total_nsec;
+        max_nsec = (results[i].max_nsec > max_nsec) ? results[i].max_nsec : max_nsec;
+    }
+    atomic_store(&producers_done, true);
+    pthread_join(consumer, NULL);
+
+    printf("  %2zu producers, %s: %7.1f ns, worst %8.1f us\n", producer_count, use_ring ? "ring " : "mutex",
+           (double)total_nsec / (double)(producer_count * SUBMISSIONS_PER_PRODUCER), (double)max_nsec / 1000.0);
+}
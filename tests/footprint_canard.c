@@ -0,0 +1,69 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Prints the sizes of the memory blocks that Libcanard requests (canardTxGetItemSize(), canardRxGetSessionSize(),
+ * canardRxGetPayloadBufferSize()) next to what they take from o1heap, which rounds each request plus its overhead
+ * up to a power of two, and from a pool of o1heap_pool.h, which only rounds up to the pool alignment.
+ * Use it to size the pools of the TX and RX nodes for the target. Run it with `make bench`.
+ *
+ */
+
+#include <libcanard/canard.h>
+#include <o1heap/o1heap.h>
+#include <o1heap/o1heap_pool.h>
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Function prototypes
+static size_t heapFragmentSize(const size_t amount);
+static size_t poolBlockSize(const size_t amount);
+static void printBlock(const char* const name, const size_t amount);
+
+// Extents of some common data types: Heartbeat, a small message, GetInfo response, a large register value
+static const size_t rx_extents[] = { 12, 64, 313, 1024 };
+
+int main(void)
+{
+    printf("Memory blocks requested by Libcanard, bytes: requested, o1heap fragment, pool block\n");
+    printBlock("TX item, classic CAN (MTU 8)", canardTxGetItemSize(CANARD_MTU_CAN_CLASSIC));
+    printBlock("TX item, CAN FD (MTU 64)", canardTxGetItemSize(CANARD_MTU_CAN_FD));
+    printBlock("RX session", canardRxGetSessionSize());
+    for(size_t i = 0; i < (sizeof(rx_extents) / sizeof(rx_extents[0])); i++)
+    {
+        char name[64];
+        (void) snprintf(name, sizeof(name), "RX payload buffer, extent %zu", rx_extents[i]);
+        printBlock(name, canardRxGetPayloadBufferSize(rx_extents[i]));
+    }
+    printf("Storage per remote node of canardRxSubscribeWithPool(), bytes:\n");
+    for(size_t i = 0; i < (sizeof(rx_extents) / sizeof(rx_extents[0])); i++)
+    {
+        printf("  extent %4zu: %5zu\n", rx_extents[i], canardRxGetSessionPoolSlotSize(rx_extents[i]));
+    }
+    return 0;
+}
+
+/* The fragment that o1heapAllocate() takes for the amount: the amount plus the header, rounded up to a power of two. */
+static size_t heapFragmentSize(const size_t amount)
+{
+    size_t out = O1HEAP_ALIGNMENT * 2U;
+    while(out < (amount + O1HEAP_ALIGNMENT))
+    {
+        out <<= 1U;
+    }
+    return out;
+}
+
+static size_t poolBlockSize(const size_t amount)
+{
+    return (amount + (O1HEAP_POOL_ALIGNMENT - 1U)) & ~(O1HEAP_POOL_ALIGNMENT - 1U);
+}
+
+static void printBlock(const char* const name, const size_t amount)
+{
+    const size_t fragment = heapFragmentSize(amount);
+    printf("  %-34s %5zu %5zu (%3zu%% used) %5zu\n", name, amount, fragment, (amount * 100U) / fragment,
+           poolBlockSize(amount));
+}
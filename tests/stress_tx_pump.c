@@ -0,0 +1,356 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Concurrency stress test of the TX pump, meant to run under ThreadSanitizer (`make stress`).
+ * Several producers push transfers to one Libcanard instance at once, half of them with
+ * tx_pump_push() and half through the ring with tx_pump_submit(), while another thread uses
+ * the instance for reception under tx_pump_lock(). The instance allocates from an o1heap
+ * shared by all threads through the per-thread caches.
+ * The transport is a pair of AF_UNIX datagram sockets, which need no CAN interfaces; the
+ * frames are read back on the other ends and checked for completeness and order.
+ * The second run adds a third interface that nobody reads, like a dead redundant bus: the
+ * other two shall still get every frame, and the dead one loses its oldest frames to overruns
+ * until it comes back at the end.
+ *
+ */
+
+#include <libcanard/canard.h>
+#include <o1heap/o1heap.h>
+#include <o1heap/o1heap_cache.h>
+#include <socketcan/socketcan.h>
+#include <socketcan/tx_pump.h>
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+// Defines
+#define PRODUCERS 4
+#define TRANSFERS_PER_PRODUCER 1000
+#define IFACES 2
+#define IFACES_MAX (IFACES + 1)
+// Large enough for every transfer to wait in the queue at once, so that none is dropped by the ring
+#define HEAP_SIZE (1024 * 1024)
+#define TX_RING_CAPACITY 16
+#define RX_SUBJECT_ID 1000
+#define RX_ITERATIONS 2000
+#define DEADLINE_USEC 60000000
+#define SINK_TIMEOUT_SEC 10
+#define DRAIN_TIMEOUT_MSEC 100
+
+// Function prototypes
+static void* memAllocate(CanardInstance* const ins, const size_t amount);
+static void memFree(CanardInstance* const ins, void* const pointer);
+static void heapLock(void);
+static void heapUnlock(void);
+static int runScenario(const bool dead_iface);
+static void* runPump(void* arg);
+static void* runProducer(void* arg);
+static void* runReceiver(void* arg);
+static void* runSink(void* arg);
+static void* runDrain(void* arg);
+
+static _Alignas(O1HEAP_ALIGNMENT) uint8_t heap_arena[HEAP_SIZE];
+static O1HeapInstance* heap;
+static pthread_mutex_t heap_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static CanardInstance ins;
+static socketcan_transport transport;
+static tx_pump pump;
+static tx_ring ring;
+static tx_ring_slot ring_slots[TX_RING_CAPACITY];
+static atomic_bool pump_done;
+
+// The receiving end of each interface and what has been read from it
+static int sink_sockets[IFACES_MAX];
+static size_t sink_frames[IFACES_MAX];
+static size_t sink_out_of_order[IFACES_MAX];
+
+int main(void)
+{
+    int failures = 0;
+    printf("Two interfaces:\n");
+    failures += runScenario(false);
+    printf("Two interfaces and a dead one:\n");
+    failures += runScenario(true);
+    printf((failures > 0) ? "FAILED\n" : "All checks passed\n");
+    return (failures > 0) ? 1 : 0;
+}
+
+static void* memAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return o1heapCacheAllocate(heap, amount);
+}
+
+static void memFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    o1heapCacheFree(heap, pointer);
+}
+
+static void heapLock(void)
+{
+    pthread_mutex_lock(&heap_mutex);
+}
+
+static void heapUnlock(void)
+{
+    pthread_mutex_unlock(&heap_mutex);
+}
+
+/* Runs the producers, the receiver and the pump to completion on a fresh instance and checks what arrived.
+ * With dead_iface, the last interface is not read until the live ones got everything. Returns the failure count. */
+static int runScenario(const bool dead_iface)
+{
+    heap = o1heapInit(heap_arena, sizeof(heap_arena), &heapLock, &heapUnlock);
+    if(heap == NULL)
+    {
+        fprintf(stderr, "Heap init failed\n");
+        return 1;
+    }
+
+    // Stand-ins for the CAN interfaces; try_send() only needs sockets that take datagrams.
+    const size_t iface_count = dead_iface ? IFACES_MAX : IFACES;
+    memset(&transport, 0, sizeof(transport));
+    memset(sink_frames, 0, sizeof(sink_frames));
+    memset(sink_out_of_order, 0, sizeof(sink_out_of_order));
+    transport.epoll_fd = -1;
+    transport.iface_count = iface_count;
+    for(size_t i = 0; i < iface_count; i++)
+    {
+        int pair[2];
+        if(socketpair(AF_UNIX, SOCK_DGRAM, 0, pair) < 0)
+        {
+            perror("Socketpair");
+            return 1;
+        }
+        transport.sockets[i] = pair[0];
+        transport.mtu[i] = CANFD_MTU;
+        sink_sockets[i] = pair[1];
+    }
+
+    ins = canardInit(&memAllocate, &memFree);
+    ins.mtu_bytes = CANARD_MTU_CAN_FD;
+    ins.node_id = 96;
+    if(tx_pump_init(&pump, &ins, &transport) < 0)
+    {
+        return 1;
+    }
+    tx_ring_init(&ring, ring_slots, TX_RING_CAPACITY);
+    tx_pump_set_ring(&pump, &ring);
+    atomic_store(&pump_done, false);
+
+    pthread_t pump_thread;
+    pthread_t receiver_thread;
+    pthread_t producer_threads[PRODUCERS];
+    pthread_t sink_threads[IFACES_MAX];
+    size_t producer_ids[PRODUCERS];
+    size_t sink_ids[IFACES_MAX];
+    pthread_create(&pump_thread, NULL, &runPump, NULL);
+    for(size_t i = 0; i < IFACES; i++)
+    {
+        sink_ids[i] = i;
+        pthread_create(&sink_threads[i], NULL, &runSink, &sink_ids[i]);
+    }
+    pthread_create(&receiver_thread, NULL, &runReceiver, NULL);
+    for(size_t i = 0; i < PRODUCERS; i++)
+    {
+        producer_ids[i] = i;
+        pthread_create(&producer_threads[i], NULL, &runProducer, &producer_ids[i]);
+    }
+
+    for(size_t i = 0; i < PRODUCERS; i++)
+    {
+        pthread_join(producer_threads[i], NULL);
+    }
+    pthread_join(receiver_thread, NULL);
+    for(size_t i = 0; i < IFACES; i++)
+    {
+        pthread_join(sink_threads[i], NULL);
+    }
+    // The live interfaces are done before the dead one comes back, so they cannot have waited for it.
+    if(dead_iface)
+    {
+        sink_ids[IFACES] = IFACES;
+        pthread_create(&sink_threads[IFACES], NULL, &runDrain, &sink_ids[IFACES]);
+    }
+    tx_pump_stop(&pump);
+    pthread_join(pump_thread, NULL);
+    if(dead_iface)
+    {
+        pthread_join(sink_threads[IFACES], NULL);
+    }
+
+    int failures = 0;
+    const size_t expected = (size_t)PRODUCERS * TRANSFERS_PER_PRODUCER;
+    for(size_t i = 0; i < IFACES; i++)
+    {
+        printf("Interface %zu: %zu/%zu frames, %zu out of order\n", i, sink_frames[i], expected, sink_out_of_order[i]);
+        failures += ((sink_frames[i] != expected) || (sink_out_of_order[i] > 0)) ? 1 : 0;
+    }
+    printf("Pump: %lu frames staged, %lu expired, %lu overrun, %lu send errors, %lu wakeups; ring: %lu push errors\n",
+           (unsigned long)pump.frames_staged, (unsigned long)pump.frames_expired, (unsigned long)pump.frames_overrun,
+           (unsigned long)pump.send_errors, (unsigned long)pump.wakeups, (unsigned long)ring.push_errors);
+    failures += ((pump.frames_expired > 0) || (pump.send_errors > 0) || (ring.push_errors > 0)) ? 1 : 0;
+    if(dead_iface)
+    {
+        // Every frame either reached the dead interface once it came back or was overrun on it.
+        printf("Dead interface: %zu frames after it came back\n", sink_frames[IFACES]);
+        failures += ((pump.frames_overrun == 0) || (sink_frames[IFACES] + pump.frames_overrun != expected)) ? 1 : 0;
+    }
+    else
+    {
+        failures += (pump.frames_overrun > 0) ? 1 : 0;
+    }
+
+    tx_pump_close(&pump);
+    for(size_t i = 0; i < iface_count; i++)
+    {
+        close(transport.sockets[i]);
+        close(sink_sockets[i]);
+    }
+    o1heapCacheFlush();
+    return failures;
+}
+
+static void* runPump(void* arg)
+{
+    (void) arg;
+    if(tx_pump_run(&pump) < 0)
+    {
+        fprintf(stderr, "Pump failed\n");
+    }
+    o1heapCacheFlush();
+    atomic_store(&pump_done, true);
+    return NULL;
+}
+
+/* Publishes single-frame transfers on a subject of its own, so that its frames keep their order in the queue.
+ * The even producers lock the instance, the odd ones go through the ring; both retry while the queue is full. */
+static void* runProducer(void* arg)
+{
+    const size_t id = *(const size_t*)arg;
+    uint8_t payload[7] = {0};
+    payload[0] = (uint8_t)id;
+    for(size_t k = 0; k < TRANSFERS_PER_PRODUCER; k++)
+    {
+        const CanardTransfer transfer = {
+            .timestamp_usec = socketcan_monotonic_usec() + DEADLINE_USEC,
+            .priority = CanardPriorityNominal,
+            .transfer_kind = CanardTransferKindMessage,
+            .port_id = (CanardPortID)id,
+            .remote_node_id = CANARD_NODE_ID_UNSET,
+            .transfer_id = (CanardTransferID)k,
+            .payload_size = sizeof(payload),
+            .payload = payload,
+        };
+        while((id % 2U == 0U) ? (tx_pump_push(&pump, &transfer) < 0) : (tx_pump_submit(&pump, &transfer) < 0))
+        {
+            sched_yield();
+        }
+    }
+    o1heapCacheFlush();
+    return NULL;
+}
+
+/* Feeds single-frame transfers to the same instance, as the application would for its own subscriptions. */
+static void* runReceiver(void* arg)
+{
+    (void) arg;
+    CanardRxSubscription subscription;
+    tx_pump_lock(&pump);
+    (void) canardRxSubscribe(&ins, CanardTransferKindMessage, RX_SUBJECT_ID, 8,
+                             CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, &subscription);
+    tx_pump_unlock(&pump);
+
+    uint8_t payload[8] = {0};
+    for(size_t k = 0; k < RX_ITERATIONS; k++)
+    {
+        payload[7] = (uint8_t)(0xE0U | (k & CANARD_TRANSFER_ID_MAX));  // Start, end, toggle
+        const CanardFrame frame = {
+            .timestamp_usec = socketcan_monotonic_usec(),
+            .extended_can_id = (4UL << 26U) | (3UL << 21U) | ((uint32_t)RX_SUBJECT_ID << 8U) | 10U,
+            .payload_size = sizeof(payload),
+            .payload = payload,
+        };
+        CanardTransfer transfer;
+        tx_pump_lock(&pump);
+        if(canardRxAccept(&ins, &frame, 0, &transfer) > 0)
+        {
+            canardRxReleasePayload(&ins, &transfer);
+        }
+        tx_pump_unlock(&pump);
+    }
+
+    tx_pump_lock(&pump);
+    (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, RX_SUBJECT_ID);
+    tx_pump_unlock(&pump);
+    o1heapCacheFlush();
+    return NULL;
+}
+
+/* Reads the frames of one interface until all of them arrived or nothing comes for a while. The transfer-ID in
+ * the tail byte shall follow the previous frame of the same producer. */
+static void* runSink(void* arg)
+{
+    const size_t iface = *(const size_t*)arg;
+    const struct timeval timeout = { .tv_sec = SINK_TIMEOUT_SEC, .tv_usec = 0 };
+    (void) setsockopt(sink_sockets[iface], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    size_t next_transfer_id[PRODUCERS] = {0};
+    while(sink_frames[iface] < (size_t)PRODUCERS * TRANSFERS_PER_PRODUCER)
+    {
+        struct canfd_frame frame;
+        if(recv(sink_sockets[iface], &frame, sizeof(frame), 0) != (ssize_t)sizeof(frame))
+        {
+            break;
+        }
+        const size_t producer = (frame.can_id >> 8U) & CANARD_SUBJECT_ID_MAX;
+        const size_t transfer_id = frame.data[frame.len - 1U] & CANARD_TRANSFER_ID_MAX;
+        if((producer >= PRODUCERS) || (transfer_id != (next_transfer_id[producer] & CANARD_TRANSFER_ID_MAX)))
+        {
+            sink_out_of_order[iface]++;
+        }
+        else
+        {
+            next_transfer_id[producer]++;
+        }
+        sink_frames[iface]++;
+    }
+    return NULL;
+}
+
+/* Reads whatever the dead interface has until the pump has stopped and nothing more comes. */
+static void* runDrain(void* arg)
+{
+    const size_t iface = *(const size_t*)arg;
+    const struct timeval timeout = { .tv_sec = 0, .tv_usec = DRAIN_TIMEOUT_MSEC * 1000 };
+    (void) setsockopt(sink_sockets[iface], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    for(;;)
+    {
+        // Read the flag first: the frames sent before the pump stopped are all queued by then.
+        const bool done = atomic_load(&pump_done);
+        struct canfd_frame frame;
+        if(recv(sink_sockets[iface], &frame, sizeof(frame), 0) == (ssize_t)sizeof(frame))
+        {
+            sink_frames[iface]++;
+        }
+        else if(done)
+        {
+            break;
+        }
+        else
+        {
+            (void) 0;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,650 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Regression checks for the Libcanard extensions used by the TX and RX nodes.
+ * Run them with `make test`; the exit status is nonzero if any check fails.
+ *
+ */
+
+#include <libcanard/canard.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Defines
+#define CHECK(x) check((x), #x, __LINE__)
+#define TX_SLAB_SIZE 8192
+#define TX_PAYLOAD_SIZE_MAX 8192
+#define TX_SLAB_SLOTS_MAX 128
+#define RX_BATCH_FRAMES_MAX 16
+// Long enough to take the bulk path of every CANARD_CONFIG_CRC option and many frames
+#define CRC_PAYLOAD_SIZE 1000
+// The TX items the limited allocator lets exist at once
+#define TX_BATCH_ITEMS_MAX 7
+
+// Private to canard.c, exported by CANARD_CONFIG_EXPOSE_PRIVATE
+int32_t txAddFrameCount(const int32_t total, const int32_t frame_count);
+
+// Function prototypes
+static void* memAllocate(CanardInstance* const ins, const size_t amount);
+static void memFree(CanardInstance* const ins, void* const pointer);
+static void* memAllocateLimited(CanardInstance* const ins, const size_t amount);
+static void memFreeLimited(CanardInstance* const ins, void* const pointer);
+static void check(const int condition, const char* const text, const int line);
+static size_t drainTxQueue(CanardInstance* const ins);
+static void testTxSlabRejectsOversizedTransfer(const CanardTxOverflowPolicy policy);
+static void testTxSlabHeldFrames(void);
+static void testTxExpire(void);
+static void testTxPushBatch(void);
+static uint32_t makeMessageCANID(const CanardPortID subject_id, const CanardNodeID source_node_id);
+static void testRxPayloadPool(void);
+static void testRxReleaseForeignPayload(void);
+static void testRxBatchPooledSession(void);
+static void testRxBatchOutputFull(void);
+static void testRxManySources(void);
+static uint16_t crcReference(const size_t size, const uint8_t* const data);
+static uint16_t transmitAndReceive(const size_t size, const uint8_t* const payload);
+static void testTransferCRC(void);
+
+static int failures = 0;
+static size_t live_allocations = 0;
+
+int main(void)
+{
+    testTxSlabRejectsOversizedTransfer(CanardTxOverflowDropOldest);
+    testTxSlabRejectsOversizedTransfer(CanardTxOverflowDropLowestPriority);
+    testTxSlabHeldFrames();
+    testTxExpire();
+    testTxPushBatch();
+    testRxPayloadPool();
+    testRxReleaseForeignPayload();
+    testRxBatchPooledSession();
+    testRxBatchOutputFull();
+    testRxManySources();
+    testTransferCRC();
+    if(failures > 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+static void* memAllocate(CanardInstance* const ins, const size_t amount)
+{
+    (void) ins;
+    return malloc(amount);
+}
+
+static void memFree(CanardInstance* const ins, void* const pointer)
+{
+    (void) ins;
+    free(pointer);
+}
+
+/* Fails once TX_BATCH_ITEMS_MAX blocks are in use. */
+static void* memAllocateLimited(CanardInstance* const ins, const size_t amount)
+{
+    void* out = NULL;
+    if(live_allocations < TX_BATCH_ITEMS_MAX)
+    {
+        out = memAllocate(ins, amount);
+        live_allocations += (out != NULL) ? 1U : 0U;
+    }
+    return out;
+}
+
+static void memFreeLimited(CanardInstance* const ins, void* const pointer)
+{
+    if(pointer != NULL)
+    {
+        live_allocations--;
+    }
+    memFree(ins, pointer);
+}
+
+static void check(const int condition, const char* const text, const int line)
+{
+    if(!condition)
+    {
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, text);
+        failures++;
+    }
+}
+
+/* Empties the TX queue and returns the number of frames that were in it. */
+static size_t drainTxQueue(CanardInstance* const ins)
+{
+    size_t out = 0;
+    for(const CanardFrame* frame = canardTxPeek(ins); frame != NULL; frame = canardTxPeek(ins))
+    {
+        canardTxPop(ins);
+        canardTxFree(ins, frame);
+        out++;
+    }
+    return out;
+}
+
+/* A transfer that needs more slots than the slab has shall be rejected without evicting the queued transfers. */
+static void testTxSlabRejectsOversizedTransfer(const CanardTxOverflowPolicy policy)
+{
+    static _Alignas(8) uint8_t storage[TX_SLAB_SIZE];
+    static uint8_t payload[TX_PAYLOAD_SIZE_MAX];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    const int32_t slot_count = canardTxInitSlab(&ins, storage, sizeof(storage), policy);
+    CHECK(slot_count > 3);
+
+    // Three single-frame transfers at the lowest priority, so that either policy may evict them.
+    CanardTransfer transfer = {
+        .timestamp_usec = 0,
+        .priority = CanardPriorityOptional,
+        .transfer_kind = CanardTransferKindMessage,
+        .port_id = 1000,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .payload_size = 7,
+        .payload = payload,
+    };
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        transfer.transfer_id = i;
+        CHECK(canardTxPush(&ins, &transfer) == 1);
+    }
+
+    // One frame more than the slab can hold, at a higher priority.
+    const size_t mtu = CANARD_MTU_CAN_FD - 1U;
+    transfer.priority = CanardPriorityNominal;
+    transfer.port_id = 10;
+    transfer.payload_size = ((size_t)slot_count * mtu) - 1U;
+    CHECK(transfer.payload_size <= sizeof(payload));
+    CHECK(canardTxPush(&ins, &transfer) == -CANARD_ERROR_OUT_OF_MEMORY);
+    CHECK(drainTxQueue(&ins) == 3);
+}
+
+/* The frames popped and held by the application cannot be evicted, so they do not count as room for a new transfer.
+ * A frame allocated from the heap before the slab was installed is returned to the heap, not to the slab. */
+static void testTxSlabHeldFrames(void)
+{
+    static _Alignas(8) uint8_t storage[TX_SLAB_SIZE];
+    uint8_t payload[15] = {0};
+    const CanardFrame* held[TX_SLAB_SLOTS_MAX];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    ins.mtu_bytes = CANARD_MTU_CAN_CLASSIC;
+    CanardTransfer transfer = {
+        .timestamp_usec = 0,
+        .priority = CanardPriorityNominal,
+        .transfer_kind = CanardTransferKindMessage,
+        .port_id = 1000,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .payload_size = 7,
+        .payload = payload,
+    };
+
+    // One frame from the heap, held over the installation of the slab.
+    CHECK(canardTxPush(&ins, &transfer) == 1);
+    const CanardFrame* const heap_frame = canardTxPeek(&ins);
+    canardTxPop(&ins);
+    const int32_t slot_count = canardTxInitSlab(&ins, storage, sizeof(storage), CanardTxOverflowDropOldest);
+    CHECK((slot_count > 4) && (slot_count <= TX_SLAB_SLOTS_MAX));
+    CHECK(canardTxInitSlab(&ins, storage, sizeof(storage), CanardTxOverflowDropOldest) ==
+          -CANARD_ERROR_INVALID_ARGUMENT);
+    canardTxFree(&ins, heap_frame);
+
+    // Fill the slab, then hold all but two of its frames.
+    for(int32_t i = 0; i < slot_count; i++)
+    {
+        transfer.transfer_id = (CanardTransferID)i;
+        CHECK(canardTxPush(&ins, &transfer) == 1);
+    }
+    for(int32_t i = 0; i < (slot_count - 2); i++)
+    {
+        held[i] = canardTxPeek(&ins);
+        canardTxPop(&ins);
+    }
+
+    // Three frames do not fit in the two slots that could be freed; nothing shall be evicted for it.
+    transfer.payload_size = sizeof(payload);
+    CHECK(canardTxPush(&ins, &transfer) == -CANARD_ERROR_OUT_OF_MEMORY);
+    transfer.payload_size = 7;
+    CHECK(canardTxPush(&ins, &transfer) == 1);  // Evicts the oldest one.
+    CHECK(drainTxQueue(&ins) == 2);
+
+    // Once the held frames are released, the slab is whole again.
+    for(int32_t i = 0; i < (slot_count - 2); i++)
+    {
+        canardTxFree(&ins, held[i]);
+    }
+    for(int32_t i = 0; i < slot_count; i++)
+    {
+        CHECK(canardTxPush(&ins, &transfer) == 1);
+    }
+    CHECK(drainTxQueue(&ins) == (size_t)slot_count);
+}
+
+/* Expired transfers are removed as a whole, wherever they are in the queue, and the rest keeps its order.
+ * This runs against either implementation of canardTxExpire(), see CANARD_CONFIG_TX_DEADLINE_INDEX. */
+static void testTxExpire(void)
+{
+    static uint8_t payload[100];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    ins.mtu_bytes = CANARD_MTU_CAN_CLASSIC;
+    CanardTransfer transfer = {
+        .priority = CanardPriorityNominal,
+        .transfer_kind = CanardTransferKindMessage,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .payload = payload,
+    };
+
+    // Subject-IDs give the order in the queue; the deadlines are interleaved with it.
+    const CanardMicrosecond deadlines[4] = {1000, 3000, 500, 2000};
+    const size_t sizes[4] = {20, 3, 20, 3};
+    int32_t frames[4];
+    for(size_t i = 0; i < 4; i++)
+    {
+        transfer.timestamp_usec = deadlines[i];
+        transfer.port_id = (CanardPortID)(100 + i);
+        transfer.payload_size = sizes[i];
+        frames[i] = canardTxPush(&ins, &transfer);
+        CHECK(frames[i] > 0);
+    }
+
+    size_t transfers = 0;
+    CHECK(canardTxExpire(&ins, 500, &transfers) == 0);
+    CHECK(transfers == 0);
+    CHECK(canardTxExpire(&ins, 1500, &transfers) == (frames[0] + frames[2]));
+    CHECK(transfers == 2);
+
+    const CanardFrame* frame = canardTxPeek(&ins);
+    CHECK((frame != NULL) && (((frame->extended_can_id >> 8U) & CANARD_SUBJECT_ID_MAX) == 101));
+    CHECK(canardTxExpire(&ins, 2500, &transfers) == frames[3]);
+    CHECK(transfers == 1);
+    CHECK(canardTxPeek(&ins) == frame);
+    CHECK(drainTxQueue(&ins) == (size_t)frames[1]);
+    CHECK(canardTxExpire(&ins, UINT64_MAX, &transfers) == 0);
+}
+
+/* A failure in the middle of a batch affects only the failed transfer: the invalid one and the one that runs out of
+ * memory are not enqueued at all, while those before and after them are enqueued completely. */
+static void testTxPushBatch(void)
+{
+    CanardInstance ins = canardInit(&memAllocateLimited, &memFreeLimited);
+    ins.node_id = 42;
+    ins.mtu_bytes = CANARD_MTU_CAN_CLASSIC;
+    uint8_t payload[20] = {0};
+    CanardTransfer transfers[5];
+    for(size_t i = 0; i < 5; i++)
+    {
+        transfers[i] = (CanardTransfer){
+            .timestamp_usec = 0,
+            .priority = CanardPriorityNominal,
+            .transfer_kind = CanardTransferKindMessage,
+            .port_id = (CanardPortID)(100U + i),
+            .remote_node_id = CANARD_NODE_ID_UNSET,
+            .transfer_id = 0,
+            .payload_size = ((i % 2U) == 0U) ? 7U : sizeof(payload),  // One frame or four frames
+            .payload = payload,
+        };
+    }
+    transfers[2].priority = (CanardPriority)(CANARD_PRIORITY_MAX + 1U);
+    // 1 + 4 frames fit, the next 4 do not, the last 1 does once the partial transfer is rolled back.
+    int32_t results[5] = {0};
+    CHECK(canardTxPushBatch(&ins, transfers, 5, results) == 6);
+    CHECK((results[0] == 1) && (results[1] == 4) && (results[2] == -CANARD_ERROR_INVALID_ARGUMENT));
+    CHECK((results[3] == -CANARD_ERROR_OUT_OF_MEMORY) && (results[4] == 1));
+    CHECK(live_allocations == 6);
+    size_t frame_count = 0;
+    for(const CanardFrame* frame = canardTxPeek(&ins); frame != NULL; frame = canardTxPeek(&ins))
+    {
+        CHECK(((frame->extended_can_id >> 8U) & CANARD_SUBJECT_ID_MAX) != 103U);
+        canardTxPop(&ins);
+        canardTxFree(&ins, frame);
+        frame_count++;
+    }
+    CHECK((frame_count == 6) && (live_allocations == 0));
+
+    CHECK(canardTxPushBatch(&ins, NULL, 0, NULL) == 0);
+    CHECK(canardTxPushBatch(&ins, NULL, 1, results) == -CANARD_ERROR_INVALID_ARGUMENT);
+    CHECK(canardTxPushBatch(NULL, transfers, 1, results) == -CANARD_ERROR_INVALID_ARGUMENT);
+
+    // Too many frames to enqueue for real, so the total is checked at the point of accumulation.
+    CHECK(txAddFrameCount(5, 4) == 9);
+    CHECK(txAddFrameCount(INT32_MAX - 4, 4) == INT32_MAX);
+    CHECK(txAddFrameCount(INT32_MAX - 3, 4) == INT32_MAX);
+    CHECK(txAddFrameCount(INT32_MAX, 1) == INT32_MAX);
+}
+
+static uint32_t makeMessageCANID(const CanardPortID subject_id, const CanardNodeID source_node_id)
+{
+    // Nominal priority, the two reserved bits set, as in canardTxPush().
+    return (4UL << 26U) | (3UL << 21U) | ((uint32_t)subject_id << 8U) | source_node_id;
+}
+
+/* Released payloads are reused by the next transfer; anonymous transfers on pooled subscriptions are delivered by
+ * reference to the frame, because there is no session to lend a buffer from and the pool shall not allocate. */
+static void testRxPayloadPool(void)
+{
+    static _Alignas(8) uint8_t storage[4096];
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    CanardRxSubscription heap_sub;
+    CanardRxSubscription pool_sub;
+    CHECK(canardRxSubscribe(&ins, CanardTransferKindMessage, 100, 16, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                            &heap_sub) == 1);
+    CHECK(canardRxSubscribeWithPool(&ins, CanardTransferKindMessage, 200, 16, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                                    storage, sizeof(storage), &pool_sub) == 1);
+
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 0};
+    CanardFrame frame = {
+        .timestamp_usec = 1,
+        .extended_can_id = makeMessageCANID(100, 10),
+        .payload_size = sizeof(payload),
+        .payload = payload,
+    };
+    CanardTransfer transfer;
+    for(uint8_t tid = 0; tid < 2; tid++)
+    {
+        payload[7] = (uint8_t)(0xE0U | tid);  // Start, end, toggle
+        CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+        CHECK((transfer.payload_size == 7) && (memcmp(transfer.payload, payload, 7) == 0));
+        canardRxReleasePayload(&ins, &transfer);
+    }
+    const CanardRxPayloadPoolStats stats = canardRxGetPayloadPoolStats(&heap_sub);
+    CHECK((stats.hits == 1) && (stats.misses == 1));
+
+    frame.extended_can_id = makeMessageCANID(200, 0x55) | (UINT32_C(1) << 24U);  // Anonymous
+    CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+    CHECK((transfer.payload == payload) && (transfer.payload_size == 7));
+    CHECK(canardRxGetPayloadPoolStats(&pool_sub).misses == 0);
+
+    CHECK(canardRxUnsubscribe(&ins, CanardTransferKindMessage, 100) == 1);
+    CHECK(canardRxUnsubscribe(&ins, CanardTransferKindMessage, 200) == 1);
+}
+
+/* A buffer lent before the subscription was re-created with a larger extent is too small for the new transfers, and
+ * a zero-copy payload is the frame buffer: releasing either shall leave the free list of the subscription alone. */
+static void testRxReleaseForeignPayload(void)
+{
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    CanardRxSubscription sub;
+    CHECK(canardRxSubscribe(&ins, CanardTransferKindMessage, 100, 8, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                            &sub) == 1);
+
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 0xE0U};  // Start, end, toggle
+    const CanardFrame frame = {
+        .timestamp_usec = 1,
+        .extended_can_id = makeMessageCANID(100, 10),
+        .payload_size = sizeof(payload),
+        .payload = payload,
+    };
+    CanardTransfer old_transfer;
+    CHECK(canardRxAccept(&ins, &frame, 0, &old_transfer) == 1);
+    CHECK(old_transfer.payload_buffer_size == canardRxGetPayloadBufferSize(8));
+
+    // Re-created with a larger extent; the old buffer shall be freed rather than recycled.
+    CHECK(canardRxSubscribe(&ins, CanardTransferKindMessage, 100, 64, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                            &sub) == 0);
+    canardRxReleasePayload(&ins, &old_transfer);
+    CanardTransfer transfer;
+    CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+    CHECK(transfer.payload_buffer_size == canardRxGetPayloadBufferSize(64));
+    CHECK((canardRxGetPayloadPoolStats(&sub).hits == 0) && (canardRxGetPayloadPoolStats(&sub).misses == 1));
+    canardRxReleasePayload(&ins, &transfer);
+
+    // A zero-copy payload is not a buffer of the library, so it is not taken into the free list.
+    CHECK(canardRxSetZeroCopy(&ins, CanardTransferKindMessage, 100, true) == 1);
+    payload[7] = 0xE1U;
+    CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+    CHECK((transfer.payload == payload) && (transfer.payload_buffer_size == 0));
+    canardRxReleasePayload(&ins, &transfer);
+    CHECK(canardRxSetZeroCopy(&ins, CanardTransferKindMessage, 100, false) == 1);
+    for(uint8_t tid = 2; tid < 4; tid++)
+    {
+        payload[7] = (uint8_t)(0xE0U | tid);
+        CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+        CHECK(transfer.payload != payload);
+        canardRxReleasePayload(&ins, &transfer);
+    }
+    // One buffer in circulation: recycled twice, never replaced by the frame buffer.
+    CHECK((canardRxGetPayloadPoolStats(&sub).hits == 2) && (canardRxGetPayloadPoolStats(&sub).misses == 1));
+    CHECK(canardRxUnsubscribe(&ins, CanardTransferKindMessage, 100) == 1);
+}
+
+/* Two multi-frame transfers from the same node in one batch: the first one is lent from the pooled session, so the
+ * batch shall stop before the second one overwrites it. */
+static void testRxBatchPooledSession(void)
+{
+    static _Alignas(8) uint8_t storage[4096];
+    static uint8_t frame_payloads[RX_BATCH_FRAMES_MAX][CANARD_MTU_CAN_CLASSIC];
+    CanardFrame frames[RX_BATCH_FRAMES_MAX];
+    size_t frame_count = 0;
+
+    // Let a classic CAN node 10 produce the frames.
+    CanardInstance tx = canardInit(&memAllocate, &memFree);
+    tx.node_id = 10;
+    tx.mtu_bytes = CANARD_MTU_CAN_CLASSIC;
+    for(uint8_t tid = 0; tid < 2; tid++)
+    {
+        uint8_t payload[20];
+        memset(payload, (tid == 0) ? 0x11 : 0x22, sizeof(payload));
+        const CanardTransfer transfer = {
+            .timestamp_usec = 1000,
+            .priority = CanardPriorityNominal,
+            .transfer_kind = CanardTransferKindMessage,
+            .port_id = 300,
+            .remote_node_id = CANARD_NODE_ID_UNSET,
+            .transfer_id = tid,
+            .payload_size = sizeof(payload),
+            .payload = payload,
+        };
+        CHECK(canardTxPush(&tx, &transfer) == 4);
+    }
+    for(const CanardFrame* frame = canardTxPeek(&tx); frame != NULL; frame = canardTxPeek(&tx))
+    {
+        CHECK(frame_count < RX_BATCH_FRAMES_MAX);
+        memcpy(frame_payloads[frame_count], frame->payload, frame->payload_size);
+        frames[frame_count] = *frame;
+        frames[frame_count].payload = frame_payloads[frame_count];
+        frame_count++;
+        canardTxPop(&tx);
+        canardTxFree(&tx, frame);
+    }
+    CHECK(frame_count == 8);
+
+    CanardInstance rx = canardInit(&memAllocate, &memFree);
+    rx.node_id = 42;
+    CanardRxSubscription sub;
+    CHECK(canardRxSubscribeWithPool(&rx, CanardTransferKindMessage, 300, 32, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                                    storage, sizeof(storage), &sub) == 1);
+    CanardTransfer transfers[RX_BATCH_FRAMES_MAX];
+    size_t processed = 0;
+    size_t offset = 0;
+    for(uint8_t fill = 0x11; fill <= 0x22; fill += 0x11)
+    {
+        CHECK(canardRxAcceptBatch(&rx, &frames[offset], frame_count - offset, 0, transfers, RX_BATCH_FRAMES_MAX,
+                                  &processed) == 1);
+        CHECK(processed == 4);
+        const uint8_t* const payload = (const uint8_t*)transfers[0].payload;
+        CHECK(transfers[0].payload_size == 20);
+        for(size_t i = 0; i < transfers[0].payload_size; i++)
+        {
+            CHECK(payload[i] == fill);
+        }
+        offset += processed;
+    }
+    CHECK(canardRxUnsubscribe(&rx, CanardTransferKindMessage, 300) == 1);
+}
+
+/* A batch of single-frame transfers into an output of three: the processing stops at the full output, and the rest
+ * of the frames follow in the next call. */
+static void testRxBatchOutputFull(void)
+{
+    static uint8_t frame_payloads[RX_BATCH_FRAMES_MAX][8];
+    CanardFrame frames[RX_BATCH_FRAMES_MAX];
+    for(size_t i = 0; i < RX_BATCH_FRAMES_MAX; i++)
+    {
+        frame_payloads[i][7] = (uint8_t)(0xE0U | (i & CANARD_TRANSFER_ID_MAX));  // Start, end, toggle
+        frames[i] = (CanardFrame){
+            .timestamp_usec = 1 + i,
+            .extended_can_id = makeMessageCANID(100, 10),
+            .payload_size = sizeof(frame_payloads[i]),
+            .payload = frame_payloads[i],
+        };
+    }
+
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = 42;
+    CanardRxSubscription sub;
+    CHECK(canardRxSubscribe(&ins, CanardTransferKindMessage, 100, 8, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                            &sub) == 1);
+    CanardTransfer transfers[3];
+    size_t offset = 0;
+    size_t received = 0;
+    while(offset < RX_BATCH_FRAMES_MAX)
+    {
+        size_t processed = 0;
+        const int32_t result = canardRxAcceptBatch(&ins, &frames[offset], RX_BATCH_FRAMES_MAX - offset, 0, transfers,
+                                                   3, &processed);
+        const size_t left = RX_BATCH_FRAMES_MAX - offset;
+        CHECK((result == ((left < 3) ? (int32_t)left : 3)) && (processed == (size_t)result));
+        for(int32_t i = 0; i < result; i++)
+        {
+            CHECK(transfers[i].transfer_id == ((offset + (size_t)i) & CANARD_TRANSFER_ID_MAX));
+            canardRxReleasePayload(&ins, &transfers[i]);
+        }
+        received += (result > 0) ? (size_t)result : 0U;
+        offset += (processed > 0) ? processed : left;
+    }
+    CHECK(received == RX_BATCH_FRAMES_MAX);
+    CHECK(canardRxAcceptBatch(&ins, frames, 1, 0, NULL, 0, NULL) == -CANARD_ERROR_INVALID_ARGUMENT);
+    CHECK(canardRxUnsubscribe(&ins, CanardTransferKindMessage, 100) == 1);
+}
+
+/* Every node-ID publishes on the same subject, in a scattered order, so that the sessions are inserted in the middle
+ * of the sparse container as it grows to its full capacity. Each node shall keep a session of its own: a repeated
+ * transfer-ID is a duplicate for the same node only. */
+static void testRxManySources(void)
+{
+    CanardInstance ins = canardInit(&memAllocate, &memFree);
+    ins.node_id = CANARD_NODE_ID_MAX;
+    CanardRxSubscription sub;
+    CHECK(canardRxSubscribe(&ins, CanardTransferKindMessage, 100, 8, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
+                            &sub) == 1);
+    uint8_t payload[8] = {0};
+    CanardFrame frame = {
+        .timestamp_usec = 1,
+        .payload_size = sizeof(payload),
+        .payload = payload,
+    };
+    for(uint8_t tid = 0; tid < 2; tid++)
+    {
+        for(size_t i = 0; i <= CANARD_NODE_ID_MAX; i++)
+        {
+            const CanardNodeID source = (CanardNodeID)((i * 37U) % (CANARD_NODE_ID_MAX + 1U));  // A permutation
+            frame.extended_can_id = makeMessageCANID(100, source);
+            payload[0] = source;
+            payload[7] = (uint8_t)(0xE0U | tid);  // Start, end, toggle
+            CanardTransfer transfer;
+            CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 1);
+            CHECK((transfer.remote_node_id == source) && (((const uint8_t*)transfer.payload)[0] == source));
+            canardRxReleasePayload(&ins, &transfer);
+            // The same transfer again is a duplicate.
+            CHECK(canardRxAccept(&ins, &frame, 0, &transfer) == 0);
+        }
+#if CANARD_CONFIG_SPARSE_RX_SESSIONS
+        CHECK(sub._session_capacity == (CANARD_NODE_ID_MAX + 1U));
+#endif
+    }
+    CHECK(canardRxUnsubscribe(&ins, CanardTransferKindMessage, 100) == 1);
+}
+
+/* CRC-16/CCITT-FALSE one bit at a time, independent of CANARD_CONFIG_CRC. */
+static uint16_t crcReference(const size_t size, const uint8_t* const data)
+{
+    uint16_t crc = 0xFFFFU;
+    for(size_t i = 0; i < size; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8U);
+        for(uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1U) ^ 0x1021U) : (uint16_t)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+/* Sends a multi-frame transfer over classic CAN, which has no padding, and receives it back. Returns the transfer CRC
+ * found after the payload in the frames. */
+static uint16_t transmitAndReceive(const size_t size, const uint8_t* const payload)
+{
+    static uint8_t stream[CRC_PAYLOAD_SIZE + 2U];
+    CanardInstance tx = canardInit(&memAllocate, &memFree);
+    tx.node_id = 10;
+    tx.mtu_bytes = CANARD_MTU_CAN_CLASSIC;
+    const CanardTransfer transfer = {
+        .timestamp_usec = 1000,
+        .priority = CanardPriorityNominal,
+        .transfer_kind = CanardTransferKindMessage,
+        .port_id = 200,
+        .remote_node_id = CANARD_NODE_ID_UNSET,
+        .transfer_id = 0,
+        .payload_size = size,
+        .payload = payload,
+    };
+    CHECK((size > (CANARD_MTU_CAN_CLASSIC - 1U)) && (size <= CRC_PAYLOAD_SIZE));
+    CHECK(canardTxPush(&tx, &transfer) > 1);
+
+    CanardInstance rx = canardInit(&memAllocate, &memFree);
+    rx.node_id = 42;
+    CanardRxSubscription sub;
+    CHECK(canardRxSubscribe(&rx, CanardTransferKindMessage, 200, CRC_PAYLOAD_SIZE,
+                            CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, &sub) == 1);
+    size_t stream_size = 0;
+    size_t received = 0;
+    for(const CanardFrame* frame = canardTxPeek(&tx); frame != NULL; frame = canardTxPeek(&tx))
+    {
+        // Everything but the tail byte.
+        CHECK((stream_size + frame->payload_size - 1U) <= sizeof(stream));
+        memcpy(&stream[stream_size], frame->payload, frame->payload_size - 1U);
+        stream_size += frame->payload_size - 1U;
+        CanardTransfer out;
+        if(canardRxAccept(&rx, frame, 0, &out) == 1)
+        {
+            CHECK((out.payload_size == size) && (memcmp(out.payload, payload, size) == 0));
+            canardRxReleasePayload(&rx, &out);
+            received++;
+        }
+        canardTxPop(&tx);
+        canardTxFree(&tx, frame);
+    }
+    CHECK((received == 1) && (stream_size == (size + 2U)));
+    CHECK(canardRxUnsubscribe(&rx, CanardTransferKindMessage, 200) == 1);
+    return (uint16_t)((stream[size] << 8U) | stream[size + 1U]);
+}
+
+/* The transfer CRC is CRC-16/CCITT-FALSE whichever CANARD_CONFIG_CRC option computes it: the check value of
+ * "123456789" is 0x29B1. A long payload at an odd address matches the bitwise reference, and the receiving side
+ * validates it with the same implementation. */
+static void testTransferCRC(void)
+{
+    static const uint8_t check_input[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    CHECK(crcReference(sizeof(check_input), check_input) == 0x29B1U);
+    CHECK(transmitAndReceive(sizeof(check_input), check_input) == 0x29B1U);
+
+    static uint8_t payload[CRC_PAYLOAD_SIZE + 1U];
+    for(size_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = (uint8_t)((i * 131U) + (i >> 8U));
+    }
+    for(size_t size = CRC_PAYLOAD_SIZE - 7U; size <= CRC_PAYLOAD_SIZE; size++)
+    {
+        CHECK(transmitAndReceive(size, &payload[1]) == crcReference(size, &payload[1]));
+    }
+}
@@ -0,0 +1,401 @@
+/*
+ * Distributed under The MIT License.
+ *
+ * Description:
+ *
+ * Regression checks for the o1heap extensions: the fragment histograms of o1heapGetExtendedDiagnostics()
+ * and the allocator layers built on top of the heap (o1heap_pool.h, o1heap_arena.h).
+ * The heap source is included here so that the checks can walk its free lists and fragments; build it with
+ * O1HEAP_FRAGMENT_HISTOGRAMS=1. Run them with `make test`; the exit status is nonzero if any check fails.
+ *
+ */
+
+#include <o1heap/o1heap.c>
+#include <o1heap/o1heap_pool.h>
+#include <o1heap/o1heap_arena.h>
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// Defines
+#define CHECK(x) check((x), #x, __LINE__)
+#define LIVE_BLOCKS_MAX 64
+#define RANDOM_STEPS 4000
+#define RANDOM_AMOUNT_MAX 600
+#define RANDOM_HEAP_SIZE 32768
+#define FRAGMENTED_HEAP_SIZE 4096
+#define POOL_HEAP_SIZE 8192
+#define POOL_STORAGE_SIZE 1024
+// An arena of this size holds one block of this size and no other, so every block takes an arena of its own
+#define ARENA_SIZE 8192
+#define ARENA_BLOCK_SIZE 3000
+#define ARENA_COOLDOWN_USEC 100000
+// Not a multiple of any page size, so that the rounding is visible
+#define ARENA_MAP_SIZE ((3UL * 1024UL * 1024UL) + 1UL)
+
+// Function prototypes
+static void check(const int condition, const char* const text, const int line);
+static uint32_t nextRandom(void);
+static int histogramsMatchHeap(const O1HeapInstance* const handle);
+static void testHistogramsMatchWalk(void);
+static void testFragmentation(void);
+static void testPoolInitValidation(void);
+static void testPoolExhaustedFallback(void);
+static void testPoolOwnsRouting(void);
+static void sleepUsec(const uint64_t usec);
+static void testArenaSetGrowAndTrim(void);
+static void testArenaMapAllFlags(void);
+
+static int failures = 0;
+static uint32_t random_state = 12345U;
+
+int main(void)
+{
+    testHistogramsMatchWalk();
+    testFragmentation();
+    testPoolInitValidation();
+    testPoolExhaustedFallback();
+    testPoolOwnsRouting();
+    testArenaSetGrowAndTrim();
+    testArenaMapAllFlags();
+    if(failures > 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+static void check(const int condition, const char* const text, const int line)
+{
+    if(!condition)
+    {
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, text);
+        failures++;
+    }
+}
+
+static uint32_t nextRandom(void)
+{
+    // xorshift32; deterministic so that a failure can be reproduced.
+    random_state ^= random_state << 13U;
+    random_state ^= random_state >> 17U;
+    random_state ^= random_state << 5U;
+    return random_state;
+}
+
+/* Compares the reported histograms with a count of the free lists of the bins and of the used fragments in the
+ * address order. Returns nonzero if they match. */
+static int histogramsMatchHeap(const O1HeapInstance* const handle)
+{
+    size_t free_counts[NUM_BINS_MAX] = {0};
+    size_t allocated_counts[NUM_BINS_MAX] = {0};
+    for(size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        for(const Fragment* frag = handle->bins[i]; frag != NULL; frag = frag->next_free)
+        {
+            free_counts[i]++;
+        }
+    }
+    const Fragment* frag = (const Fragment*)(const void*)(((const uint8_t*)handle) + INSTANCE_SIZE_PADDED);
+    for(; frag != NULL; frag = frag->header.next)
+    {
+        if(frag->header.used)
+        {
+            allocated_counts[log2Floor(frag->header.size / FRAGMENT_SIZE_MIN)]++;
+        }
+    }
+
+    O1HeapExtendedDiagnostics diag;
+    o1heapGetExtendedDiagnostics(handle, &diag);
+    int match = 1;
+    for(size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        match = match && (diag.free_fragments[i] == free_counts[i]) &&
+                (diag.allocated_fragments[i] == allocated_counts[i]);
+    }
+    return match;
+}
+
+/* Random allocations and deallocations of various sizes; after every step, the per-bin counts shall match the heap. */
+static void testHistogramsMatchWalk(void)
+{
+    static _Alignas(O1HEAP_ALIGNMENT) uint8_t arena[RANDOM_HEAP_SIZE];
+    O1HeapInstance* const heap = o1heapInit(arena, sizeof(arena), NULL, NULL);
+    CHECK(heap != NULL);
+    void* blocks[LIVE_BLOCKS_MAX] = {NULL};
+    size_t mismatches = 0;
+    for(size_t k = 0; k < RANDOM_STEPS; k++)
+    {
+        void** const slot = &blocks[nextRandom() % LIVE_BLOCKS_MAX];
+        if(*slot != NULL)
+        {
+            o1heapFree(heap, *slot);
+            *slot = NULL;
+        }
+        else
+        {
+            *slot = o1heapAllocate(heap, 1U + (nextRandom() % RANDOM_AMOUNT_MAX));
+        }
+        mismatches += histogramsMatchHeap(heap) ? 0U : 1U;
+    }
+    CHECK(mismatches == 0);
+    CHECK(o1heapDoInvariantsHold(heap));
+    for(size_t i = 0; i < LIVE_BLOCKS_MAX; i++)
+    {
+        o1heapFree(heap, blocks[i]);
+    }
+    O1HeapExtendedDiagnostics diag;
+    o1heapGetExtendedDiagnostics(heap, &diag);
+    CHECK(diag.basic.allocated == 0);
+    CHECK(histogramsMatchHeap(heap));
+}
+
+/* A small heap filled with the smallest fragments, every other one freed: half of the memory is free, yet nothing
+ * larger than one fragment can be allocated, and the histograms tell why. */
+static void testFragmentation(void)
+{
+    static _Alignas(O1HEAP_ALIGNMENT) uint8_t arena[FRAGMENTED_HEAP_SIZE];
+    O1HeapInstance* const heap = o1heapInit(arena, sizeof(arena), NULL, NULL);
+    CHECK(heap != NULL);
+    void* blocks[FRAGMENTED_HEAP_SIZE / FRAGMENT_SIZE_MIN] = {NULL};
+    const size_t amount = FRAGMENT_SIZE_MIN - O1HEAP_ALIGNMENT;
+    size_t count = 0;
+    while((count < (sizeof(blocks) / sizeof(blocks[0]))) && ((blocks[count] = o1heapAllocate(heap, amount)) != NULL))
+    {
+        count++;
+    }
+    CHECK(count == o1heapGetDiagnostics(heap).capacity / FRAGMENT_SIZE_MIN);
+    for(size_t i = 0; i < count; i += 2)
+    {
+        o1heapFree(heap, blocks[i]);
+    }
+
+    const size_t freed = (count + 1U) / 2U;
+    CHECK(o1heapAllocate(heap, amount + 1U) == NULL);
+    O1HeapExtendedDiagnostics diag;
+    o1heapGetExtendedDiagnostics(heap, &diag);
+    CHECK(diag.basic.oom_count == 2);  // The one that filled the heap and the one above
+    CHECK((diag.basic.capacity - diag.basic.allocated) == (freed * FRAGMENT_SIZE_MIN));
+    CHECK(diag.largest_allocation == amount);
+    CHECK((diag.free_fragments[0] == freed) && (diag.allocated_fragments[0] == (count - freed)));
+    for(size_t i = 1; i < NUM_BINS_MAX; i++)
+    {
+        CHECK((diag.free_fragments[i] == 0) && (diag.allocated_fragments[i] == 0));
+    }
+    CHECK(histogramsMatchHeap(heap));
+    CHECK(o1heapDoInvariantsHold(heap));
+}
+
+/* The block sizes shall be strictly ascending after the rounding, fit in the storage and not exceed the class limit. */
+static void testPoolInitValidation(void)
+{
+    static _Alignas(O1HEAP_POOL_ALIGNMENT) uint8_t storage[POOL_STORAGE_SIZE];
+    O1HeapPool pool;
+    size_t counts[O1HEAP_POOL_CLASSES_MAX + 1U];
+    size_t too_many[O1HEAP_POOL_CLASSES_MAX + 1U];
+    for(size_t i = 0; i < (O1HEAP_POOL_CLASSES_MAX + 1U); i++)
+    {
+        counts[i] = 1;
+        too_many[i] = O1HEAP_POOL_ALIGNMENT * (i + 1U);
+    }
+
+    const size_t ascending[] = {O1HEAP_POOL_ALIGNMENT + 1U, O1HEAP_POOL_ALIGNMENT * 3U, 100};
+    CHECK(o1heapPoolInit(&pool, storage, sizeof(storage), ascending, counts, 3, NULL));
+    CHECK(pool.classes[0].block_size == (O1HEAP_POOL_ALIGNMENT * 2U));
+    CHECK(o1heapPoolGetStorageSize(ascending, counts, 3) ==
+          (pool.classes[0].block_size + pool.classes[1].block_size + pool.classes[2].block_size));
+
+    const size_t descending[] = {48, 24};
+    CHECK(!o1heapPoolInit(&pool, storage, sizeof(storage), descending, counts, 2, NULL));
+    const size_t same_after_rounding[] = {20, O1HEAP_POOL_ALIGNMENT * 2U};
+    CHECK(!o1heapPoolInit(&pool, storage, sizeof(storage), same_after_rounding, counts, 2, NULL));
+    const size_t equal[] = {64, 64};
+    CHECK(!o1heapPoolInit(&pool, storage, sizeof(storage), equal, counts, 2, NULL));
+
+    CHECK(o1heapPoolInit(&pool, storage, sizeof(storage), too_many, counts, O1HEAP_POOL_CLASSES_MAX, NULL));
+    CHECK(!o1heapPoolInit(&pool, storage, sizeof(storage), too_many, counts, O1HEAP_POOL_CLASSES_MAX + 1U, NULL));
+
+    const size_t large[] = {POOL_STORAGE_SIZE};
+    const size_t two[] = {2};
+    CHECK(!o1heapPoolInit(&pool, storage, sizeof(storage), large, two, 1, NULL));
+    CHECK(!o1heapPoolInit(&pool, &storage[1], sizeof(storage) - 1U, ascending, counts, 3, NULL));  // Misaligned
+}
+
+/* Requests for an exhausted pool go to the fallback heap rather than to a larger pool, and come back there. */
+static void testPoolExhaustedFallback(void)
+{
+    static _Alignas(O1HEAP_ALIGNMENT) uint8_t arena[POOL_HEAP_SIZE];
+    static _Alignas(O1HEAP_POOL_ALIGNMENT) uint8_t storage[POOL_STORAGE_SIZE];
+    O1HeapInstance* const heap = o1heapInit(arena, sizeof(arena), NULL, NULL);
+    CHECK(heap != NULL);
+    const size_t sizes[] = {32, 64};
+    const size_t counts[] = {2, 1};
+    O1HeapPool pool;
+    CHECK(o1heapPoolInit(&pool, storage, sizeof(storage), sizes, counts, 2, heap));
+
+    void* const a = o1heapPoolAllocate(&pool, 20);
+    void* const b = o1heapPoolAllocate(&pool, 32);
+    void* const c = o1heapPoolAllocate(&pool, 20);
+    CHECK((a != NULL) && (b != NULL) && (c != NULL));
+    CHECK(o1heapPoolOwns(&pool, a) && o1heapPoolOwns(&pool, b) && !o1heapPoolOwns(&pool, c));
+    CHECK((pool.classes[0].in_use == 2) && (pool.classes[0].fallback_count == 1));
+    CHECK(pool.classes[1].in_use == 0);  // Not taken by the small requests
+    CHECK(o1heapGetDiagnostics(heap).allocated > 0);
+
+    void* const d = o1heapPoolAllocate(&pool, 65);  // Larger than every pool
+    CHECK((d != NULL) && !o1heapPoolOwns(&pool, d));
+    CHECK(pool.classes[1].fallback_count == 0);
+    CHECK(o1heapPoolAllocate(&pool, 0) == NULL);
+
+    o1heapPoolFree(&pool, a);
+    o1heapPoolFree(&pool, b);
+    o1heapPoolFree(&pool, c);
+    o1heapPoolFree(&pool, d);
+    o1heapPoolFree(&pool, NULL);
+    CHECK((pool.classes[0].in_use == 0) && (pool.classes[0].peak_in_use == 2));
+    CHECK(o1heapGetDiagnostics(heap).allocated == 0);
+
+    // Without a fallback, an exhausted pool fails the request.
+    CHECK(o1heapPoolInit(&pool, storage, sizeof(storage), sizes, counts, 2, NULL));
+    void* const e = o1heapPoolAllocate(&pool, 64);
+    CHECK((e != NULL) && (o1heapPoolAllocate(&pool, 64) == NULL));
+    CHECK(pool.classes[1].fallback_count == 1);
+    o1heapPoolFree(&pool, e);
+}
+
+/* Pools chained in front of another allocator: the requests they reject go to malloc, and o1heapPoolOwns() routes
+ * each free to where the block came from, including the blocks at both ends of a pool. */
+static void testPoolOwnsRouting(void)
+{
+    static _Alignas(O1HEAP_POOL_ALIGNMENT) uint8_t storage[POOL_STORAGE_SIZE];
+    const size_t sizes[] = {16, 48};
+    const size_t counts[] = {3, 2};
+    O1HeapPool pool;
+    CHECK(o1heapPoolInit(&pool, storage, sizeof(storage), sizes, counts, 2, NULL));
+
+    void* blocks[8] = {NULL};
+    size_t pooled = 0;
+    for(size_t i = 0; i < 8; i++)
+    {
+        const size_t amount = (i % 2U == 0U) ? 16U : 40U;
+        blocks[i] = o1heapPoolAllocate(&pool, amount);
+        if(blocks[i] == NULL)
+        {
+            blocks[i] = malloc(amount);
+        }
+        pooled += o1heapPoolOwns(&pool, blocks[i]) ? 1U : 0U;
+    }
+    CHECK(pooled == 5);
+    CHECK(blocks[0] == (void*)&storage[0]);  // The first block of the first pool
+    CHECK(blocks[3] == (void*)(pool.classes[1].end - pool.classes[1].block_size));  // The last one of the last pool
+    CHECK(!o1heapPoolOwns(&pool, pool.classes[1].end));  // Just past the end
+    CHECK(!o1heapPoolOwns(&pool, NULL));
+    for(size_t i = 0; i < 8; i++)
+    {
+        if(o1heapPoolOwns(&pool, blocks[i]))
+        {
+            o1heapPoolFree(&pool, blocks[i]);
+        }
+        else
+        {
+            free(blocks[i]);
+        }
+    }
+    CHECK((pool.classes[0].in_use == 0) && (pool.classes[1].in_use == 0));
+}
+
+static void sleepUsec(const uint64_t usec)
+{
+    const struct timespec ts = { .tv_sec = (time_t)(usec / 1000000U), .tv_nsec = (long)((usec % 1000000U) * 1000U) };
+    (void) nanosleep(&ts, NULL);
+}
+
+/* The set grows by one arena per block up to O1HEAP_ARENA_COUNT_MAX and then runs out of memory. The arenas emptied
+ * in the middle are released only after the cooldown, and the remaining ones keep their order; once everything is
+ * freed, only the first arena is left. */
+static void testArenaSetGrowAndTrim(void)
+{
+    O1HeapArenaSet set;
+    CHECK(o1heapArenaSetInit(&set, ARENA_SIZE, ARENA_SIZE, ARENA_COOLDOWN_USEC, 0U));
+    void* blocks[O1HEAP_ARENA_COUNT_MAX] = {NULL};
+    void* bases[O1HEAP_ARENA_COUNT_MAX] = {NULL};
+    for(size_t i = 0; i < O1HEAP_ARENA_COUNT_MAX; i++)
+    {
+        blocks[i] = o1heapArenaSetAllocate(&set, ARENA_BLOCK_SIZE);
+        CHECK((blocks[i] != NULL) && (set.arena_count == (i + 1U)));
+        bases[i] = set.arenas[i].region.base;
+        const uint8_t* const base = (const uint8_t*)bases[i];
+        CHECK(((const uint8_t*)blocks[i] > base) && ((const uint8_t*)blocks[i] < (base + set.arenas[i].region.size)));
+    }
+    CHECK((set.grow_count == (O1HEAP_ARENA_COUNT_MAX - 1U)) && (set.oom_count == 0));
+    CHECK(o1heapArenaSetAllocate(&set, ARENA_BLOCK_SIZE) == NULL);
+    CHECK((set.arena_count == O1HEAP_ARENA_COUNT_MAX) && (set.oom_count == 1));
+
+    // Two arenas in the middle become empty; they stay until the cooldown has passed.
+    o1heapArenaSetFree(&set, blocks[2]);
+    o1heapArenaSetFree(&set, blocks[4]);
+    CHECK((o1heapArenaSetTrim(&set) == 0) && (set.arena_count == O1HEAP_ARENA_COUNT_MAX));
+    sleepUsec(ARENA_COOLDOWN_USEC * 2U);
+    CHECK(o1heapArenaSetTrim(&set) == 2);
+    CHECK((set.arena_count == (O1HEAP_ARENA_COUNT_MAX - 2U)) && (set.release_count == 2));
+    size_t next = 0;
+    for(size_t i = 0; i < O1HEAP_ARENA_COUNT_MAX; i++)
+    {
+        if((i != 2) && (i != 4))
+        {
+            CHECK((set.arenas[next].region.base == bases[i]) && (set.arenas[next].allocation_count == 1));
+            next++;
+        }
+    }
+
+    // The arena mapped for the next block comes last.
+    blocks[2] = o1heapArenaSetAllocate(&set, ARENA_BLOCK_SIZE);
+    CHECK((blocks[2] != NULL) && (set.arena_count == (O1HEAP_ARENA_COUNT_MAX - 1U)));
+    blocks[4] = NULL;
+
+    for(size_t i = 0; i < O1HEAP_ARENA_COUNT_MAX; i++)
+    {
+        o1heapArenaSetFree(&set, blocks[i]);
+    }
+    CHECK(set.arena_count == (O1HEAP_ARENA_COUNT_MAX - 1U));
+    sleepUsec(ARENA_COOLDOWN_USEC * 2U);
+    CHECK(o1heapArenaSetTrim(&set) == (O1HEAP_ARENA_COUNT_MAX - 2U));
+    CHECK((set.arena_count == 1) && (set.arenas[0].region.base == bases[0]) && (set.arenas[0].allocation_count == 0));
+    CHECK(o1heapGetDiagnostics(set.arenas[0].heap).allocated == 0);
+    o1heapArenaSetDestroy(&set);
+    CHECK(set.arena_count == 0);
+}
+
+/* Whichever of the options the system supports, the region is aligned and rounded to the huge page size, and it is
+ * usable as a heap arena; without options, it is rounded to the page size only. */
+static void testArenaMapAllFlags(void)
+{
+    const uint32_t flags = O1HEAP_ARENA_FLAG_HUGEPAGES | O1HEAP_ARENA_FLAG_NUMA_LOCAL | O1HEAP_ARENA_FLAG_PREFAULT;
+    O1HeapArenaRegion region;
+    CHECK(o1heapArenaMap(ARENA_MAP_SIZE, flags, &region));
+    CHECK((region.base != NULL) && (((uintptr_t)region.base % O1HEAP_ARENA_HUGEPAGE_SIZE) == 0U));
+    CHECK(region.size == (2U * O1HEAP_ARENA_HUGEPAGE_SIZE));
+    CHECK(region.numa_node >= -1);
+    O1HeapInstance* const heap = o1heapInit(region.base, region.size, NULL, NULL);
+    CHECK(heap != NULL);
+    CHECK(o1heapGetDiagnostics(heap).capacity > (region.size - ARENA_SIZE));
+    void* const block = o1heapAllocate(heap, ARENA_MAP_SIZE / 2U);
+    CHECK(block != NULL);
+    memset(block, 0xA5, ARENA_MAP_SIZE / 2U);
+    o1heapFree(heap, block);
+    CHECK(o1heapDoInvariantsHold(heap));
+    o1heapArenaUnmap(&region);
+
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    CHECK(o1heapArenaMap(ARENA_MAP_SIZE, 0U, &region));
+    CHECK((((uintptr_t)region.base % page_size) == 0U) && (region.size == (ARENA_MAP_SIZE + page_size - 1U)));
+    CHECK((!region.hugetlb) && (region.numa_node == -1));
+    CHECK(o1heapInit(region.base, region.size, NULL, NULL) != NULL);
+    o1heapArenaUnmap(&region);
+}